@@ -1,15 +1,17 @@
 @echo off
 REM Batch file to build or clean DES encryption project on Windows
 
-REM Compiler and flags
-set CC=gcc
-set CFLAGS=-Wall -Wextra -std=c99 -I%INCLUDE_DIR%
-
 REM Directories
-set INCLUDE_DIR=inc
+set INCLUDE_DIR=include
 set SRC_DIR=src
 set OBJ_DIR=obj
 set BIN_DIR=bin
+set TOOLS_DIR=tools
+set GEN_DIR=gen
+
+REM Compiler and flags
+set CC=gcc
+set CFLAGS=-O2 -Wall -Wextra -std=c11 -pthread -I%INCLUDE_DIR%
 
 REM Name of the final executable
 set TARGET=%BIN_DIR%\des_encryption.exe
@@ -25,12 +27,33 @@ if not exist "%OBJ_DIR%" (
 if not exist "%BIN_DIR%" (
     mkdir "%BIN_DIR%"
 )
+if not exist "%GEN_DIR%" (
+    mkdir "%GEN_DIR%"
+)
+
+REM Generate the byte-indexed permutation LUTs from the DES tables
+echo Generating permutation lookup tables...
+%CC% %CFLAGS% -o "%BIN_DIR%\perm_compiler.exe" "%TOOLS_DIR%\perm_compiler.c" "%SRC_DIR%\des_tables.c"
+if errorlevel 1 (
+    echo Building the permutation compiler failed.
+    exit /b 1
+)
+"%BIN_DIR%\perm_compiler.exe" > "%GEN_DIR%\des_perm_luts.c"
+if errorlevel 1 (
+    echo Generating permutation lookup tables failed.
+    exit /b 1
+)
+%CC% %CFLAGS% -c "%GEN_DIR%\des_perm_luts.c" -o "%OBJ_DIR%\des_perm_luts.o"
+if errorlevel 1 (
+    echo Compilation failed for %GEN_DIR%\des_perm_luts.c
+    exit /b 1
+)
 
 REM Compile each .c file into object files
 echo Compiling source files...
 for %%f in (%SRC_DIR%\*.c) do (
     echo Compiling %%f...
-    %CC% %CFLAGS% -I%INCLUDE_DIR% -c "%%f" -o "%OBJ_DIR%\%%~nf.o"
+    %CC% %CFLAGS% -c "%%f" -o "%OBJ_DIR%\%%~nf.o"
     if errorlevel 1 (
         echo Compilation failed for %%f
         exit /b 1
@@ -39,7 +62,7 @@ for %%f in (%SRC_DIR%\*.c) do (
 
 REM Link all object files to create the executable
 echo Linking object files...
-%CC% -o "%TARGET%" %OBJ_DIR%\*.o
+%CC% -pthread -o "%TARGET%" %OBJ_DIR%\*.o
 if errorlevel 1 (
     echo Linking failed.
     exit /b 1
@@ -61,6 +84,10 @@ if exist "%BIN_DIR%" (
     echo Removing %BIN_DIR% directory and executable...
     rmdir /S /Q "%BIN_DIR%"
 )
+if exist "%GEN_DIR%" (
+    echo Removing %GEN_DIR% directory...
+    rmdir /S /Q "%GEN_DIR%"
+)
 
 echo Clean completed successfully!
 exit /b 0
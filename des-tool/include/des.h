@@ -8,6 +8,8 @@
  * 
  * This function takes an input block, applies a permutation according 
  * to the given permutation table, and stores the result in the output block.
+ * It walks the table one output bit at a time and serves as the reference
+ * for the compiled permute_lut(), which the DES rounds use.
  * 
  * @param[in] input A pointer to an array of bytes representing the input data.
  * @param[out] output A pointer to an array of bytes where the permuted result will be stored.
@@ -22,6 +24,27 @@
  */
 void permute(const uint8_t *input, uint8_t *output, const int *table, int size);
 
+/**
+ * @brief Permutes the input block using a compiled byte-indexed lookup table.
+ *
+ * Produces the same result as permute() for the table the LUT was compiled
+ * from, but costs one lookup and OR per input byte instead of a loop over
+ * every output bit. The LUTs for the DES tables are generated at build time
+ * by tools/perm_compiler.c (see des_perm_luts.h).
+ *
+ * @param[in] input A pointer to an array of bytes representing the input data.
+ * @param[out] output A pointer to an array of bytes where the permuted result will be stored.
+ * @param[in] lut The compiled table: lut[i][v] holds the output bits for input byte i with value v.
+ * @param[in] in_bytes The number of input bytes the LUT covers.
+ * @param[in] size The number of output bits (at most 64).
+ *
+ * @example
+ * uint8_t input[8] = {0x12, 0x34, 0x56, 0x78, 0x90, 0xAB, 0xCD, 0xEF};
+ * uint8_t output[8] = {0};
+ * permute_lut(input, output, IP_LUT, 8, 64);
+ */
+void permute_lut(const uint8_t *input, uint8_t *output, const uint64_t lut[][256], int in_bytes, int size);
+
 /**
  * @brief Applies the initial permutation (IP) on the input block.
  * 
@@ -0,0 +1,44 @@
+/**
+ * @file des_perm_luts.h
+ * @brief Byte-indexed lookup tables for the DES permutations.
+ *
+ * The definitions are generated at build time by tools/perm_compiler.c from
+ * the tables in des_tables.h. For a permutation with an N-byte input,
+ * LUT[i][v] holds the output bits contributed by input byte i having value v,
+ * pre-positioned MSB-first in a 64-bit word. The full permutation is the OR
+ * of N lookups (see permute_lut()).
+ *
+ * SP_LUT combines each S-box with the P permutation for the SP-table engine
+ * in des_sp.h.
+ */
+
+#ifndef DES_PERM_LUTS_H
+#define DES_PERM_LUTS_H
+
+#include <stdint.h>
+
+/** @brief IP: 8 input bytes -> 64 output bits. */
+extern const uint64_t IP_LUT[8][256];
+
+/** @brief FP: 8 input bytes -> 64 output bits. */
+extern const uint64_t FP_LUT[8][256];
+
+/** @brief PC-1: 8 input bytes -> 56 output bits. */
+extern const uint64_t PC1_LUT[8][256];
+
+/** @brief PC-2: 7 input bytes -> 48 output bits. */
+extern const uint64_t PC2_LUT[7][256];
+
+/** @brief E: 4 input bytes -> 48 output bits. */
+extern const uint64_t E_LUT[4][256];
+
+/** @brief P: 4 input bytes -> 32 output bits. */
+extern const uint64_t P_LUT[4][256];
+
+/**
+ * @brief S-box + P: SP_LUT[box][x] is P applied to the output of S-box 'box'
+ *        for the 6-bit input x, as a 32-bit word (DES bit 1 is the MSB).
+ */
+extern const uint32_t SP_LUT[8][64];
+
+#endif // DES_PERM_LUTS_H
@@ -0,0 +1,79 @@
+/**
+ * @file des_sp.h
+ * @brief SP-table DES engine operating on 32-bit halves with a precomputed key schedule.
+ */
+
+#ifndef DES_SP_H
+#define DES_SP_H
+
+#include <stdint.h>
+
+/**
+ * @brief A precomputed DES key schedule in the SP engine's layout.
+ *
+ * subkeys[r][j] is the 6-bit chunk of round key r that is XORed into the
+ * input of S-box j. The schedule is a pure bit permutation of the key, so
+ * schedules of keys that differ in some bits differ by the XOR of the
+ * schedules of those bits; des_keysearch() relies on this to update it
+ * incrementally.
+ */
+typedef struct
+{
+    uint8_t subkeys[16][8];
+} des_sp_key_t;
+
+/**
+ * @brief Expands a 64-bit DES key into an SP engine key schedule.
+ *
+ * @param[in] key A pointer to the 8-byte key (parity bits are ignored).
+ * @param[out] ks A pointer to the key schedule to fill.
+ *
+ * @example
+ * uint8_t key[8] = {0x13, 0x34, 0x57, 0x79, 0x9B, 0xBC, 0xDF, 0xF1};
+ * des_sp_key_t ks;
+ * des_sp_set_key(key, &ks);
+ */
+void des_sp_set_key(const uint8_t *key, des_sp_key_t *ks);
+
+/**
+ * @brief Runs the 16 Feistel rounds on a block that has already been through IP.
+ *
+ * Leaves out the initial and final permutations so that callers testing many
+ * keys against one block can apply them once.
+ *
+ * @param[in] ks A pointer to the key schedule.
+ * @param[in] permuted The block after IP, DES bit 1 in the most significant bit.
+ * @param[in] mode 1 for encryption, 0 for decryption.
+ * @return The pre-output block (R16 || L16), ready for FP.
+ */
+uint64_t des_sp_rounds(const des_sp_key_t *ks, uint64_t permuted, int mode);
+
+/**
+ * @brief Encrypts or decrypts one block held in a 64-bit word.
+ *
+ * @param[in] ks A pointer to the key schedule.
+ * @param[in] block The 64-bit block, DES bit 1 in the most significant bit.
+ * @param[in] mode 1 for encryption, 0 for decryption.
+ * @return The transformed block.
+ */
+uint64_t des_sp_crypt_block(const des_sp_key_t *ks, uint64_t block, int mode);
+
+/**
+ * @brief Drop-in replacement for des() built on the SP engine.
+ *
+ * Produces bit-identical results to des(), with the rounds done on 32-bit
+ * words through the combined S-box/P tables (SP_LUT).
+ *
+ * @param[in,out] block A pointer to an 8-byte block, transformed in place.
+ * @param[in] key A pointer to an 8-byte key.
+ * @param[in] mode 1 for encryption, 0 for decryption.
+ *
+ * @example
+ * uint8_t block[8] = {0x01, 0x23, 0x45, 0x67, 0x89, 0xAB, 0xCD, 0xEF};
+ * uint8_t key[8] = {0x13, 0x34, 0x57, 0x79, 0x9B, 0xBC, 0xDF, 0xF1};
+ * des_sp(block, key, 1);
+ * // 'block' now contains 85 E8 13 54 0F 0A B4 05.
+ */
+void des_sp(uint8_t *block, uint8_t *key, int mode);
+
+#endif // DES_SP_H
@@ -0,0 +1,36 @@
+/**
+ * @file des_tables.h
+ * @brief DES permutation, shift and S-box tables (FIPS 46-3).
+ *
+ * Permutation tables list, for each output bit, the 1-based index of the
+ * input bit it is taken from (bit 1 is the most significant bit of byte 0).
+ */
+
+#ifndef DES_TABLES_H
+#define DES_TABLES_H
+
+/** @brief Initial Permutation (IP): 64 -> 64 bits. */
+extern const int IP_TABLE[64];
+
+/** @brief Final Permutation (FP = IP^-1): 64 -> 64 bits. */
+extern const int FP_TABLE[64];
+
+/** @brief Permuted Choice 1 (PC-1): 64-bit key -> 56 bits. */
+extern const int PC1[56];
+
+/** @brief Permuted Choice 2 (PC-2): 56 bits -> 48-bit round key. */
+extern const int PC2[48];
+
+/** @brief Left-rotation amount of the key halves for each of the 16 rounds. */
+extern const int SHIFTS[16];
+
+/** @brief Expansion (E): 32 -> 48 bits. */
+extern const int E_TABLE[48];
+
+/** @brief Feistel output permutation (P): 32 -> 32 bits. */
+extern const int P_TABLE[32];
+
+/** @brief The eight S-boxes, indexed by [box][row][column]. */
+extern const int S_BOX[8][4][16];
+
+#endif // DES_TABLES_H
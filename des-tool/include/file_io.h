@@ -23,24 +23,35 @@
 int file_exists(const char *filename);
 
 /**
- * @brief Handles warnings for existing ciphertext files.
+ * @brief Policies for handling an output file that may already exist.
  *
- * If the ciphertext file already exists, this function warns the user and
- * prompts them to either append to the file or clear its contents. It returns
- * 1 if the user chooses to append and 0 if the user chooses to clear the file.
+ * None of the policies prompt the user, so the tool never blocks waiting for
+ * input when it is run unattended.
+ */
+typedef enum
+{
+    OUTPUT_POLICY_OVERWRITE, ///< Truncate an existing file (default).
+    OUTPUT_POLICY_APPEND,    ///< Append to an existing file.
+    OUTPUT_POLICY_FAIL,      ///< Refuse to write if the file already exists.
+    OUTPUT_POLICY_ATOMIC     ///< Write a temp file in the same directory, fsync it, then rename it over the target.
+} output_policy_t;
+
+/**
+ * @brief Parses the argument of the --output-policy option.
+ *
+ * Accepted names are "overwrite", "append", "fail" and "atomic".
  *
- * @param[in] filename A pointer to a string representing the name of the ciphertext file.
- * @return Returns 1 if the user chooses to append, 0 if the user chooses to clear the file.
+ * @param[in] name A pointer to the policy name given on the command line.
+ * @param[out] policy A pointer to where the parsed policy will be stored.
+ * @return Returns 1 if the name is a known policy, otherwise 0.
  *
  * @example
- * int action = handle_ciphertext_file("output.txt");
- * if (action == 1) {
- *     // Append to the file
- * } else {
- *     // Clear the file content
+ * output_policy_t policy;
+ * if (!parse_output_policy("atomic", &policy)) {
+ *     // Unknown policy name
  * }
  */
-int handle_ciphertext_file(const char *filename);
+int parse_output_policy(const char *name, output_policy_t *policy);
 
 /**
  * @brief Converts a hexadecimal string to a byte array (8-byte key).
@@ -120,16 +131,19 @@ void add_padding(uint8_t *block, size_t *block_size);
  *
  * This function removes padding from the given block according to the
  * PKCS#5/PKCS#7 padding scheme. The padding length is determined by the
- * value of the last byte in the block, and the block size is adjusted
- * accordingly.
+ * value of the last byte in the block, every padding byte is checked to hold
+ * that value, and the block size is adjusted accordingly.
  *
  * @param[in,out] block A pointer to the block from which padding will be removed.
  * @param[in,out] block_size A pointer to the current size of the block,
  *                           which will be updated to reflect the new size
  *                           after removing the padding.
  *
- * @note The function ensures that the padding length is valid (between 1 and 8).
- *       If the padding length is invalid, no changes are made to the block size.
+ * @return Returns 1 if the padding is valid, otherwise 0.
+ *
+ * @note The padding length must be between 1 and 8, and no larger than the
+ *       block. Invalid padding, the usual result of a wrong key or corrupt
+ *       ciphertext, leaves the block size unchanged.
  *
  * @example
  * uint8_t block[8] = {0x12, 0x34, 0x56, 0x78, 0x9A, 0x03, 0x03, 0x03};
@@ -138,14 +152,24 @@ void add_padding(uint8_t *block, size_t *block_size);
  * // block now contains: 0x12 0x34 0x56 0x78 0x9A
  * // block_size is updated to 5
  */
-void remove_padding(uint8_t *block, size_t *block_size);
+int remove_padding(uint8_t *block, size_t *block_size);
+
+/**
+ * @brief Size of the in-memory chunk used when streaming files through DES.
+ *
+ * Must be a multiple of the 8-byte DES block size.
+ */
+#define IO_CHUNK_SIZE (64 * 1024)
 
 /**
  * @brief Processes files for encryption or decryption using the DES algorithm.
  *
- * This function reads blocks of data from the input file (plaintext or ciphertext),
- * processes them using DES encryption or decryption based on the mode, and writes
- * the output to the specified output file.
+ * This function streams the input file (plaintext or ciphertext) through DES in
+ * chunks of IO_CHUNK_SIZE bytes and writes the result to the output file. Every
+ * output byte is written exactly once: when decrypting, only the final block is
+ * held back in memory so that its padding can be removed before it is written.
+ * The key schedule is expanded once per call, and the blocks run on the SP
+ * engine (des_sp_crypt_block()).
  *
  * @param[in] plaintext_file A pointer to a string representing the name of the plaintext input file (for encryption) or ciphertext input file (for decryption).
  * @param[in] ciphertext_file A pointer to a string representing the name of the ciphertext output file (for encryption) or plaintext output file (for decryption).
@@ -153,12 +177,27 @@ void remove_padding(uint8_t *block, size_t *block_size);
  * @param[in] mode An integer representing the operation mode:
  *             - 1 for encryption.
  *             - 0 for decryption.
+ * @param[in] policy How to treat the output file if it already exists (see output_policy_t).
+ *
+ * @return Returns 1 on success, otherwise returns 0 and prints an error message.
+ *
+ * @note With OUTPUT_POLICY_ATOMIC the target is only replaced once the whole
+ *       output has been written and synced; on failure it is left untouched.
+ *       On POSIX the directory is synced after the rename as well.
+ * @note With the other policies a failed run removes its partial output: the
+ *       bytes appended to the file, or the file it created or truncated. This
+ *       is skipped when the output is not a regular file.
+ * @note Encryption always appends PKCS#5 padding, so an input whose length is a
+ *       multiple of 8 gains a full block of padding. Decryption rejects input
+ *       whose length is not a non-zero multiple of 8 before the output is
+ *       opened, and a final block whose padding bytes are invalid.
  *
  * @example
  * uint8_t key[8] = {0x13, 0x34, 0x57, 0x79, 0x9B, 0xBC, 0xDF, 0xF1};
- * process_files("input.txt", "output.txt", key, 1);
- * // Processes the input file for encryption and writes to the output file.
+ * if (!process_files("input.txt", "output.txt", key, 1, OUTPUT_POLICY_ATOMIC)) {
+ *     // Handle the error
+ * }
  */
-void process_files(const char *plaintext_file, const char *ciphertext_file, uint8_t *key, int mode);
+int process_files(const char *plaintext_file, const char *ciphertext_file, uint8_t *key, int mode, output_policy_t policy);
 
 #endif // FILE_IO_H
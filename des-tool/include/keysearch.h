@@ -0,0 +1,54 @@
+/**
+ * @file keysearch.h
+ * @brief Multi-threaded DES key search over a reduced keyspace.
+ */
+
+#ifndef KEYSEARCH_H
+#define KEYSEARCH_H
+
+#include <stdint.h>
+
+/**
+ * @brief Parameters of a key search.
+ *
+ * Key bits set in @c mask are unknown and are enumerated; all other bits are
+ * taken from @c base_key. Parity bits (the low bit of every key byte) do not
+ * affect DES and are never enumerated.
+ */
+typedef struct
+{
+    uint8_t plaintext[8];  ///< Known plaintext block.
+    uint8_t ciphertext[8]; ///< Ciphertext of the plaintext under the unknown key.
+    uint8_t base_key[8];   ///< Known key bits.
+    uint8_t mask[8];       ///< Unknown key bits (1 = enumerate).
+    int threads;           ///< Worker threads; 0 uses every online core.
+    int progress;          ///< Non-zero to report keys/s on stderr once per second.
+} keysearch_params_t;
+
+/**
+ * @brief Searches the masked keyspace for a key mapping plaintext to ciphertext.
+ *
+ * The keyspace is split into one contiguous range per thread. Each thread walks
+ * its range in Gray-code order, so consecutive candidates differ in a single
+ * key bit and the SP engine's key schedule is updated with one XOR per round
+ * instead of being recomputed. IP is applied once to the plaintext and FP is
+ * undone once on the ciphertext, so each candidate costs just the 16 rounds.
+ *
+ * @param[in] params A pointer to the search parameters.
+ * @param[out] found_key A pointer to an 8-byte array that receives the key if one is found.
+ * @return Returns 1 if a key was found, 0 if the keyspace was exhausted, or -1 on error.
+ *
+ * @example
+ * keysearch_params_t params = {0};
+ * hex_to_bytes("0123456789ABCDEF", params.plaintext);
+ * hex_to_bytes("85E813540F0AB405", params.ciphertext);
+ * hex_to_bytes("1334577900000000", params.base_key);
+ * hex_to_bytes("00000000FFFFFFFF", params.mask);
+ * uint8_t key[8];
+ * if (des_keysearch(&params, key) == 1) {
+ *     // 'key' now holds a matching key
+ * }
+ */
+int des_keysearch(const keysearch_params_t *params, uint8_t found_key[8]);
+
+#endif // KEYSEARCH_H
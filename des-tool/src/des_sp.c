@@ -0,0 +1,105 @@
+/**
+ * @file des_sp.c
+ * @brief SP-table DES engine.
+ *
+ * Each round computes f(R, K) as the OR of eight SP_LUT lookups. The six
+ * E-expanded bits feeding S-box j are R bits 4j..4j+5 (1-based, cyclic), so
+ * they are brought to the bottom of the word with a rotation instead of a
+ * bit-by-bit expansion. IP and FP use the compiled byte-indexed LUTs.
+ */
+
+#include <stdint.h>
+#include "des.h"
+#include "des_sp.h"
+#include "des_perm_luts.h"
+
+static inline uint32_t rotr32(uint32_t x, unsigned n)
+{
+    n &= 31;
+    return n ? (x >> n) | (x << (32 - n)) : x;
+}
+
+// Apply a 64-bit permutation LUT to a block held MSB-first in a word
+static inline uint64_t permute64(const uint64_t lut[8][256], uint64_t block)
+{
+    uint64_t bits = 0;
+    for (int i = 0; i < 8; i++)
+    {
+        bits |= lut[i][(block >> (56 - 8 * i)) & 0xFF];
+    }
+    return bits;
+}
+
+// The Feistel function on 32-bit words
+static inline uint32_t sp_feistel(uint32_t right, const uint8_t subkey[8])
+{
+    return SP_LUT[0][(rotr32(right, 27) ^ subkey[0]) & 0x3F] |
+           SP_LUT[1][(rotr32(right, 23) ^ subkey[1]) & 0x3F] |
+           SP_LUT[2][(rotr32(right, 19) ^ subkey[2]) & 0x3F] |
+           SP_LUT[3][(rotr32(right, 15) ^ subkey[3]) & 0x3F] |
+           SP_LUT[4][(rotr32(right, 11) ^ subkey[4]) & 0x3F] |
+           SP_LUT[5][(rotr32(right, 7) ^ subkey[5]) & 0x3F] |
+           SP_LUT[6][(rotr32(right, 3) ^ subkey[6]) & 0x3F] |
+           SP_LUT[7][(rotr32(right, 31) ^ subkey[7]) & 0x3F];
+}
+
+void des_sp_set_key(const uint8_t *key, des_sp_key_t *ks)
+{
+    uint8_t round_keys[16][6];
+    key_schedule((uint8_t *)key, round_keys);
+
+    // Split each 48-bit round key into its eight 6-bit S-box chunks
+    for (int r = 0; r < 16; r++)
+    {
+        uint64_t bits = 0;
+        for (int i = 0; i < 6; i++)
+        {
+            bits = (bits << 8) | round_keys[r][i];
+        }
+        for (int j = 0; j < 8; j++)
+        {
+            ks->subkeys[r][j] = (uint8_t)((bits >> (42 - 6 * j)) & 0x3F);
+        }
+    }
+}
+
+uint64_t des_sp_rounds(const des_sp_key_t *ks, uint64_t permuted, int mode)
+{
+    uint32_t left = (uint32_t)(permuted >> 32);
+    uint32_t right = (uint32_t)permuted;
+
+    // Two rounds per iteration so the halves never need to be swapped
+    for (int i = 0; i < 16; i += 2)
+    {
+        int round = (mode == 1) ? i : 15 - i;
+        int next = (mode == 1) ? i + 1 : 14 - i;
+        left ^= sp_feistel(right, ks->subkeys[round]);
+        right ^= sp_feistel(left, ks->subkeys[next]);
+    }
+
+    return ((uint64_t)right << 32) | left;
+}
+
+uint64_t des_sp_crypt_block(const des_sp_key_t *ks, uint64_t block, int mode)
+{
+    return permute64(FP_LUT, des_sp_rounds(ks, permute64(IP_LUT, block), mode));
+}
+
+void des_sp(uint8_t *block, uint8_t *key, int mode)
+{
+    des_sp_key_t ks;
+    des_sp_set_key(key, &ks);
+
+    uint64_t bits = 0;
+    for (int i = 0; i < 8; i++)
+    {
+        bits = (bits << 8) | block[i];
+    }
+
+    bits = des_sp_crypt_block(&ks, bits, mode);
+
+    for (int i = 0; i < 8; i++)
+    {
+        block[i] = (uint8_t)(bits >> (56 - 8 * i));
+    }
+}
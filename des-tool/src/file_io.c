@@ -2,14 +2,19 @@
 #include <stdint.h>
 #include <string.h>
 #include <stdlib.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <sys/types.h>
+#include <sys/stat.h> // For fstat(), fchmod() and umask()
 #ifdef _WIN32
-#include <io.h>      // For _chsize()
-#include <windows.h> // For _fileno()
+#include <io.h>      // For _commit(), _chsize_s(), _mktemp_s() and _sopen_s()
+#include <share.h>   // For _SH_DENYNO
+#include <windows.h> // For MoveFileExA()
 #else
-#include <unistd.h> // For ftruncate() and fileno()
+#include <unistd.h>   // For fsync(), ftruncate() and close()
 #endif
 #include "file_io.h"
-#include "des.h"
+#include "des_sp.h"
 
 // Function to check if a file exists
 int file_exists(const char *filename)
@@ -23,18 +28,29 @@ int file_exists(const char *filename)
     return 0;
 }
 
-// Function to handle file overwrite warning for ciphertext
-int handle_ciphertext_file(const char *filename)
+// Function to map an --output-policy name to its policy value
+int parse_output_policy(const char *name, output_policy_t *policy)
 {
-    if (file_exists(filename))
+    static const struct
     {
-        printf("Warning: %s already exists.\n", filename);
-        printf("Do you want to (a)ppend or (c)lear the contents? (a/c): ");
-        char choice;
-        scanf(" %c", &choice);
-        return (choice == 'a') ? 1 : 0; // Return 1 to append, 0 to clear
+        const char *name;
+        output_policy_t policy;
+    } policies[] = {
+        {"overwrite", OUTPUT_POLICY_OVERWRITE},
+        {"append", OUTPUT_POLICY_APPEND},
+        {"fail", OUTPUT_POLICY_FAIL},
+        {"atomic", OUTPUT_POLICY_ATOMIC},
+    };
+
+    for (size_t i = 0; i < sizeof(policies) / sizeof(policies[0]); i++)
+    {
+        if (strcmp(name, policies[i].name) == 0)
+        {
+            *policy = policies[i].policy;
+            return 1;
+        }
     }
-    return 0; // New file, no warning needed
+    return 0;
 }
 
 // Function to convert hexadecimal string to byte array (for 8-byte key)
@@ -93,76 +109,434 @@ void add_padding(uint8_t *block, size_t *block_size)
     *block_size += padding_len; // Update the block size with padding
 }
 
-void remove_padding(uint8_t *block, size_t *block_size)
+int remove_padding(uint8_t *block, size_t *block_size)
 {
     // Get the padding length from the last byte
     uint8_t padding_len = block[*block_size - 1];
+    if (padding_len == 0 || padding_len > 8 || padding_len > *block_size)
+    {
+        return 0;
+    }
+
+    // Every padding byte must hold the padding length
+    for (size_t i = *block_size - padding_len; i < *block_size; i++)
+    {
+        if (block[i] != padding_len)
+        {
+            return 0;
+        }
+    }
+
+    *block_size -= padding_len; // Adjust block size by removing padding
+    return 1;
+}
+
+// Size of a regular file; returns 0 for pipes, devices and on error
+static int regular_file_size(FILE *file, uint64_t *size)
+{
+#ifdef _WIN32
+    struct _stat64 st;
+    if (_fstat64(_fileno(file), &st) != 0 || !(st.st_mode & _S_IFREG))
+#else
+    struct stat st;
+    if (fstat(fileno(file), &st) != 0 || !S_ISREG(st.st_mode))
+#endif
+    {
+        return 0;
+    }
+    *size = (uint64_t)st.st_size;
+    return 1;
+}
+
+// Reject a ciphertext length that cannot hold whole blocks ending in a padding block
+static int check_ciphertext_length(uint64_t length)
+{
+    if (length == 0 || length % 8 != 0)
+    {
+        printf("Error: Ciphertext length must be a non-zero multiple of 8 bytes.\n");
+        return 0;
+    }
+    return 1;
+}
+
+#ifdef _WIN32
+// Names tried for the temp file of atomic output before giving up
+#define TEMP_ATTEMPTS 100
+#endif
+
+// Build "<dir>/.<name>.XXXXXX" next to the target so rename() stays on one filesystem
+static char *make_temp_path(const char *target)
+{
+    const char *slash = strrchr(target, '/');
+#ifdef _WIN32
+    const char *backslash = strrchr(target, '\\');
+    if (backslash && (!slash || backslash > slash))
+    {
+        slash = backslash;
+    }
+#endif
+    size_t dir_len = slash ? (size_t)(slash - target) + 1 : 0;
+    size_t path_len = strlen(target) + sizeof(".") + sizeof(".XXXXXX");
+
+    char *path = malloc(path_len);
+    if (path)
+    {
+        snprintf(path, path_len, "%.*s.%s.XXXXXX", (int)dir_len, target, target + dir_len);
+    }
+    return path;
+}
 
-    // Ensure padding length is valid
-    if (padding_len > 0 && padding_len <= 8)
+#ifndef _WIN32
+// fsync the directory that holds path, so that a rename() into it survives a crash
+static int sync_parent_dir(const char *path)
+{
+    const char *slash = strrchr(path, '/');
+    char *dir = slash ? strndup(path, (slash > path) ? (size_t)(slash - path) : 1) : strdup(".");
+    if (!dir)
     {
-        *block_size -= padding_len; // Adjust block size by removing padding
+        return 0;
+    }
+    int fd = open(dir, O_RDONLY);
+    free(dir);
+    if (fd < 0)
+    {
+        return 0;
+    }
+    int ok = (fsync(fd) == 0);
+    close(fd);
+    return ok;
+}
+#endif
+
+// An output file being written by process_files()
+typedef struct
+{
+    FILE *file;
+    output_policy_t policy;
+    char *temp_path;   // Temp file renamed over the target (atomic policy only)
+    int regular;       // Target is a regular file, so partial output can be undone
+    uint64_t start;    // Size of the target before this run (append policy only)
+} output_t;
+
+// Open the output file as dictated by the policy
+static FILE *open_policy_file(const char *output_file, output_policy_t policy, char **temp_path)
+{
+    *temp_path = NULL;
+
+    switch (policy)
+    {
+    case OUTPUT_POLICY_APPEND:
+        return fopen(output_file, "ab");
+
+    case OUTPUT_POLICY_FAIL:
+    {
+        // Exclusive create, so an existing file is never touched
+#ifdef _WIN32
+        int fd = _open(output_file, _O_WRONLY | _O_CREAT | _O_EXCL | _O_BINARY, 0666);
+        return (fd < 0) ? NULL : _fdopen(fd, "wb");
+#else
+        int fd = open(output_file, O_WRONLY | O_CREAT | O_EXCL, 0666);
+        return (fd < 0) ? NULL : fdopen(fd, "wb");
+#endif
+    }
+
+    case OUTPUT_POLICY_ATOMIC:
+    {
+        char *path = make_temp_path(output_file);
+        if (!path)
+        {
+            return NULL;
+        }
+#ifdef _WIN32
+        // _mktemp_s() only picks an unused name, so create the file with _O_EXCL and pick
+        // another name if a concurrent run took this one first
+        FILE *out = NULL;
+        size_t path_size = strlen(path) + 1;
+        for (int attempt = 0; attempt < TEMP_ATTEMPTS; attempt++)
+        {
+            memcpy(path + path_size - sizeof("XXXXXX"), "XXXXXX", 6);
+            int fd = -1;
+            if (_mktemp_s(path, path_size) != 0)
+            {
+                break;
+            }
+            int err = _sopen_s(&fd, path, _O_WRONLY | _O_CREAT | _O_EXCL | _O_BINARY, _SH_DENYNO,
+                               _S_IREAD | _S_IWRITE);
+            if (err == EEXIST)
+            {
+                continue;
+            }
+            if (err == 0)
+            {
+                out = _fdopen(fd, "wb");
+                if (!out)
+                {
+                    _close(fd);
+                    remove(path);
+                }
+            }
+            break;
+        }
+#else
+        int fd = mkstemp(path);
+        if (fd >= 0)
+        {
+            // mkstemp() creates the file 0600; give it the target's mode instead
+            struct stat st;
+            mode_t mask = umask(0);
+            umask(mask);
+            fchmod(fd, (stat(output_file, &st) == 0) ? (st.st_mode & 07777) : (0666 & ~mask));
+        }
+        FILE *out = (fd < 0) ? NULL : fdopen(fd, "wb");
+        if (fd >= 0 && !out)
+        {
+            close(fd);
+            remove(path);
+        }
+#endif
+        if (!out)
+        {
+            free(path);
+            return NULL;
+        }
+        *temp_path = path;
+        return out;
+    }
+
+    case OUTPUT_POLICY_OVERWRITE:
+    default:
+        return fopen(output_file, "wb");
+    }
+}
+
+// Open the output file and note what is needed to undo a failed run
+static int open_output(output_t *out, const char *output_file, output_policy_t policy)
+{
+    out->policy = policy;
+    out->file = open_policy_file(output_file, policy, &out->temp_path);
+    if (!out->file)
+    {
+        return 0;
+    }
+    out->start = 0;
+    out->regular = regular_file_size(out->file, &out->start);
+    return 1;
+}
+
+// Close the output file. For atomic output, fsync the temp file, rename it over the target
+// and fsync the directory. If the run failed, remove the partial output: the temp file,
+// the bytes appended to the target, or the target this run created or truncated.
+static int finish_output(output_t *out, const char *output_file, int ok)
+{
+    if (ok && out->temp_path)
+    {
+#ifdef _WIN32
+        if (fflush(out->file) != 0 || _commit(_fileno(out->file)) != 0)
+#else
+        if (fflush(out->file) != 0 || fsync(fileno(out->file)) != 0)
+#endif
+        {
+            perror("Error syncing output file");
+            ok = 0;
+        }
+    }
+
+    int undo = !ok && !out->temp_path && out->regular;
+    if (undo && out->policy == OUTPUT_POLICY_APPEND)
+    {
+        fflush(out->file);
+#ifdef _WIN32
+        if (_chsize_s(_fileno(out->file), (__int64)out->start) != 0)
+#else
+        if (ftruncate(fileno(out->file), (off_t)out->start) != 0)
+#endif
+        {
+            perror("Error restoring output file");
+        }
+    }
+
+    if (fclose(out->file) != 0 && ok)
+    {
+        perror("Error closing output file");
+        ok = 0;
+    }
+
+    if (undo && out->policy != OUTPUT_POLICY_APPEND)
+    {
+        remove(output_file);
+    }
+
+    if (out->temp_path)
+    {
+#ifdef _WIN32
+        if (ok && !MoveFileExA(out->temp_path, output_file, MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH))
+#else
+        if (ok && rename(out->temp_path, output_file) != 0)
+#endif
+        {
+            perror("Error renaming output file");
+            ok = 0;
+        }
+#ifndef _WIN32
+        // MoveFileExA() writes through; on POSIX the new directory entry needs its own fsync
+        else if (ok && !sync_parent_dir(output_file))
+        {
+            perror("Error syncing output directory");
+            ok = 0;
+        }
+#endif
+        if (!ok)
+        {
+            remove(out->temp_path);
+        }
+        free(out->temp_path);
+    }
+    return ok;
+}
+
+// Encrypt or decrypt every 8-byte block of a buffer in place with a prepared key schedule
+static void crypt_blocks(uint8_t *buffer, size_t length, const des_sp_key_t *ks, int mode)
+{
+    for (size_t offset = 0; offset < length; offset += 8)
+    {
+        uint8_t *block = buffer + offset;
+        uint64_t bits = 0;
+        for (int i = 0; i < 8; i++)
+        {
+            bits = (bits << 8) | block[i];
+        }
+
+        bits = des_sp_crypt_block(ks, bits, mode);
+
+        for (int i = 0; i < 8; i++)
+        {
+            block[i] = (uint8_t)(bits >> (56 - 8 * i));
+        }
     }
 }
 
 // Function to process files for encryption or decryption
-void process_files(const char *input_file, const char *output_file, uint8_t *key, int mode)
+int process_files(const char *input_file, const char *output_file, uint8_t *key, int mode, output_policy_t policy)
 {
     FILE *in = fopen(input_file, "rb");
-    FILE *out = fopen(output_file, (mode == 1) ? "ab" : "wb");
-
     if (!in)
     {
         perror("Error opening input file");
-        exit(EXIT_FAILURE);
+        return 0;
+    }
+
+    // Reject a bad ciphertext length before the output is opened, so it is never touched.
+    // Input of unknown length (a pipe) is checked once the end is reached.
+    uint64_t input_size;
+    if (mode != 1 && regular_file_size(in, &input_size) && !check_ciphertext_length(input_size))
+    {
+        fclose(in);
+        return 0;
     }
 
-    if (!out)
+    output_t out;
+    if (!open_output(&out, output_file, policy))
     {
         perror("Error opening output file");
         fclose(in);
-        exit(EXIT_FAILURE);
+        return 0;
+    }
+
+    // One extra block of headroom for the padding block appended on encryption
+    uint8_t *buffer = malloc(IO_CHUNK_SIZE + 8);
+    if (!buffer)
+    {
+        perror("Error allocating I/O buffer");
+        fclose(in);
+        finish_output(&out, output_file, 0);
+        return 0;
     }
 
-    uint8_t block[8];
-    size_t block_size;
-    size_t last_block_size = 0;
+    // The key schedule is derived once for the whole file, not once per block
+    des_sp_key_t ks;
+    des_sp_set_key(key, &ks);
+
+    int ok = 1;
+    size_t have = 0; // Bytes currently held in the buffer
 
-    while ((block_size = fread(block, 1, 8, in)) > 0)
+    for (;;)
     {
-        last_block_size = block_size;
+        size_t wanted = IO_CHUNK_SIZE - have;
+        size_t got = fread(buffer + have, 1, wanted, in);
+        have += got;
 
-        // Encrypt mode: Add padding if last block is less than 8 bytes
-        if (mode == 1 && block_size < 8)
+        if (ferror(in))
         {
-            add_padding(block, &block_size);
+            perror("Error reading input file");
+            ok = 0;
+            break;
+        }
+        if (got < wanted)
+        {
+            break; // End of input: the tail is handled below
         }
 
-        // Perform DES encryption or decryption
-        des(block, key, mode);
+        // The buffer is full. When decrypting, the last block is held back
+        // because it may turn out to be the padded final block.
+        size_t ready = (mode == 1) ? have : have - 8;
+        crypt_blocks(buffer, ready, &ks, mode);
+        if (fwrite(buffer, 1, ready, out.file) != ready)
+        {
+            perror("Error writing output file");
+            ok = 0;
+            break;
+        }
 
-        fwrite(block, 1, block_size, out);
+        memmove(buffer, buffer + ready, have - ready);
+        have -= ready;
     }
 
-    // Decrypt mode: Remove padding from the last block
-    if (mode == 0 && last_block_size == 8)
+    if (ok && mode == 1)
     {
-        fseek(out, -8, SEEK_END);
-        fread(block, 1, 8, out);
-        remove_padding(block, &last_block_size);
+        // Encrypt mode: pad the trailing partial (or empty) block
+        size_t full = have - (have % 8);
+        size_t tail = have - full;
+        add_padding(buffer + full, &tail);
+        have = full + tail;
 
-        fseek(out, -8, SEEK_END);
-        fwrite(block, 1, last_block_size, out);
+        crypt_blocks(buffer, have, &ks, mode);
+        if (fwrite(buffer, 1, have, out.file) != have)
+        {
+            perror("Error writing output file");
+            ok = 0;
+        }
+    }
+    else if (ok)
+    {
+        // Decrypt mode: the chunks are whole blocks, so the tail has the length's remainder
+        // and is empty only for empty input. Strip the padding before writing it.
+        if (!check_ciphertext_length(have))
+        {
+            ok = 0;
+        }
+        else
+        {
+            crypt_blocks(buffer, have, &ks, mode);
 
-#ifdef _WIN32
-        // Use _chsize() for Windows
-        _chsize(_fileno(out), ftell(out));
-#else
-        // Use ftruncate() for Unix-like systems
-        ftruncate(fileno(out), ftell(out));
-#endif
+            size_t last_block_size = 8;
+            if (!remove_padding(buffer + have - 8, &last_block_size))
+            {
+                printf("Error: Invalid padding in the final block (wrong key or corrupt ciphertext).\n");
+                ok = 0;
+            }
+            else
+            {
+                have = have - 8 + last_block_size;
+                if (fwrite(buffer, 1, have, out.file) != have)
+                {
+                    perror("Error writing output file");
+                    ok = 0;
+                }
+            }
+        }
     }
 
+    free(buffer);
     fclose(in);
-    fclose(out);
+    return finish_output(&out, output_file, ok);
 }
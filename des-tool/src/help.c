@@ -8,11 +8,21 @@
 // Helper function to print usage prompt
 void print_usage()
 {
-    printf("Usage: ./bin/des_encryption -m <e|d> [-k <key> | -f <keyfile>] <input_file> <output_file>\n\n");
+    printf("Usage: ./bin/des_encryption -m <e|d> [-k <key> | -f <keyfile>] [-p <policy>] <input_file> <output_file>\n\n");
+    printf("       ./bin/des_encryption --keysearch --plaintext <hex> --ciphertext <hex> --mask <hex> [-k <key>] [-t <n>]\n\n");
     printf("Options:\n");
     printf("  -m, --mode <e|d>       Specify mode: 'e' for encryption, 'd' for decryption (required)\n");
     printf("  -k, --key <key>        Key as a 16-character hexadecimal string (either -k or -f is required)\n");
     printf("  -f, --keyfile <file>   Key file (8-byte binary or 16-character hex string, either -k or -f is required)\n");
+    printf("  -p, --output-policy <policy>\n");
+    printf("                         What to do if the output file exists: 'overwrite' (default),\n");
+    printf("                         'append', 'fail', or 'atomic' (write a temp file, fsync, rename)\n");
+    printf("  -s, --keysearch        Search for the key bits selected by --mask instead of processing files\n");
+    printf("  -P, --plaintext <hex>  Known plaintext block for --keysearch (16 hex characters)\n");
+    printf("  -C, --ciphertext <hex> Ciphertext of that block for --keysearch (16 hex characters)\n");
+    printf("  -M, --mask <hex>       Unknown key bits to enumerate (16 hex characters, parity bits ignored);\n");
+    printf("                         the remaining bits are taken from -k (default all zero)\n");
+    printf("  -t, --threads <n>      Worker threads for --keysearch (default: all online cores)\n");
     printf("  -h, --help             Display this help message\n\n");
 
     printf("Positional Arguments:\n");
@@ -22,4 +32,6 @@ void print_usage()
     printf("Examples:\n");
     printf("  ./bin/des_encryption -m e -k 0123456789ABCDEF plaintext.txt ciphertext.bin\n");
     printf("  ./bin/des_encryption --mode d --keyfile keyfile.bin ciphertext.bin decrypted.txt\n");
+    printf("  ./bin/des_encryption -m e -k 0123456789ABCDEF --output-policy atomic plaintext.txt ciphertext.bin\n");
+    printf("  ./bin/des_encryption --keysearch -P 0123456789ABCDEF -C 85E813540F0AB405 -k 1334577900000000 -M 00000000FFFFFFFF\n");
 }
@@ -0,0 +1,311 @@
+/**
+ * @file keysearch.c
+ * @brief Multi-threaded DES key search built on the SP engine.
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#ifdef _WIN32
+#include <windows.h> // For GetSystemInfo() and Sleep()
+#else
+#include <unistd.h> // For sysconf()
+#endif
+#include "keysearch.h"
+#include "des_sp.h"
+#include "des_perm_luts.h"
+
+// Candidates tested between checks of the stop flag and progress updates
+#define KEYSEARCH_BATCH 4096
+
+// Upper bound on worker threads
+#define KEYSEARCH_MAX_THREADS 256
+
+// How often the reporting thread polls for completion, in milliseconds
+#define KEYSEARCH_POLL_MS 100
+
+// Cache line size assumed for keeping the shared fields apart
+#define KEYSEARCH_CACHE_LINE 64
+
+typedef struct
+{
+    uint64_t target;          // Pre-output block of the ciphertext (FP undone)
+    uint64_t permuted;        // Plaintext after IP
+    uint8_t base_key[8];      // Known key bits with unknown bits cleared
+    int free_bits[56];        // Bit index (0 = MSB of byte 0) of each enumerated key bit
+    int free_count;
+    des_sp_key_t deltas[56];  // Key schedule of each enumerated bit on its own
+
+    // Set once any worker finds the key (stored under lock). Every worker polls it in its
+    // inner loop, so it has a cache line of its own that the locked updates below leave alone.
+    _Alignas(KEYSEARCH_CACHE_LINE) atomic_int found;
+
+    _Alignas(KEYSEARCH_CACHE_LINE) pthread_mutex_t lock;
+    uint64_t tested;          // Candidates tested so far (under lock)
+    int running;              // Workers still running (under lock)
+    uint8_t found_key[8];     // Written under lock by the finder
+} keysearch_state_t;
+
+typedef struct
+{
+    keysearch_state_t *state;
+    uint64_t begin;
+    uint64_t end;
+} keysearch_worker_t;
+
+static uint64_t load_be64(const uint8_t bytes[8])
+{
+    uint64_t value = 0;
+    for (int i = 0; i < 8; i++)
+    {
+        value = (value << 8) | bytes[i];
+    }
+    return value;
+}
+
+static uint64_t permute64(const uint64_t lut[8][256], uint64_t block)
+{
+    uint64_t bits = 0;
+    for (int i = 0; i < 8; i++)
+    {
+        bits |= lut[i][(block >> (56 - 8 * i)) & 0xFF];
+    }
+    return bits;
+}
+
+static void xor_schedule(des_sp_key_t *ks, const des_sp_key_t *delta)
+{
+    uint8_t *dst = &ks->subkeys[0][0];
+    const uint8_t *src = &delta->subkeys[0][0];
+    for (size_t i = 0; i < sizeof(ks->subkeys); i++)
+    {
+        dst[i] ^= src[i];
+    }
+}
+
+// Build the key for a Gray-code index from the base key and the free bits
+static void candidate_key(const keysearch_state_t *state, uint64_t gray, uint8_t key[8])
+{
+    memcpy(key, state->base_key, 8);
+    for (int b = 0; b < state->free_count; b++)
+    {
+        if ((gray >> b) & 1)
+        {
+            int bit = state->free_bits[b];
+            key[bit / 8] |= (uint8_t)(0x80 >> (bit % 8));
+        }
+    }
+}
+
+static void *keysearch_worker(void *arg)
+{
+    keysearch_worker_t *worker = arg;
+    keysearch_state_t *state = worker->state;
+
+    uint8_t key[8];
+    des_sp_key_t ks;
+    uint64_t i = worker->begin;
+
+    if (i < worker->end)
+    {
+        candidate_key(state, i ^ (i >> 1), key);
+        des_sp_set_key(key, &ks);
+    }
+
+    while (i < worker->end && !atomic_load_explicit(&state->found, memory_order_relaxed))
+    {
+        uint64_t batch_end = (worker->end - i > KEYSEARCH_BATCH) ? i + KEYSEARCH_BATCH : worker->end;
+        uint64_t batch_start = i;
+
+        for (; i < batch_end; i++)
+        {
+            if (des_sp_rounds(&ks, state->permuted, 1) == state->target)
+            {
+                candidate_key(state, i ^ (i >> 1), key);
+                pthread_mutex_lock(&state->lock);
+                if (!atomic_load_explicit(&state->found, memory_order_relaxed))
+                {
+                    memcpy(state->found_key, key, 8);
+                    atomic_store_explicit(&state->found, 1, memory_order_relaxed);
+                }
+                pthread_mutex_unlock(&state->lock);
+                break;
+            }
+
+            // Gray code: index i + 1 differs from i in bit ctz(i + 1)
+            if (i + 1 < worker->end)
+            {
+                xor_schedule(&ks, &state->deltas[__builtin_ctzll(i + 1)]);
+            }
+        }
+
+        pthread_mutex_lock(&state->lock);
+        state->tested += i - batch_start;
+        pthread_mutex_unlock(&state->lock);
+    }
+
+    pthread_mutex_lock(&state->lock);
+    state->running--;
+    pthread_mutex_unlock(&state->lock);
+    return NULL;
+}
+
+static int online_cores(void)
+{
+#ifdef _WIN32
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    return (int)info.dwNumberOfProcessors;
+#else
+    long cores = sysconf(_SC_NPROCESSORS_ONLN);
+    return (cores > 0) ? (int)cores : 1;
+#endif
+}
+
+static double now_seconds(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+static void sleep_ms(int ms)
+{
+#ifdef _WIN32
+    Sleep(ms);
+#else
+    struct timespec ts = {ms / 1000, (long)(ms % 1000) * 1000000L};
+    nanosleep(&ts, NULL);
+#endif
+}
+
+int des_keysearch(const keysearch_params_t *params, uint8_t found_key[8])
+{
+    keysearch_state_t state;
+    memset(&state, 0, sizeof(state));
+    atomic_init(&state.found, 0);
+
+    // Collect the enumerated bits, skipping the parity bit of each byte
+    for (int bit = 0; bit < 64; bit++)
+    {
+        uint8_t bit_mask = (uint8_t)(0x80 >> (bit % 8));
+        if ((params->mask[bit / 8] & bit_mask) && (bit % 8) != 7)
+        {
+            uint8_t single[8] = {0};
+            single[bit / 8] = bit_mask;
+            des_sp_set_key(single, &state.deltas[state.free_count]);
+            state.free_bits[state.free_count++] = bit;
+        }
+    }
+    for (int i = 0; i < 8; i++)
+    {
+        state.base_key[i] = params->base_key[i] & (uint8_t)~params->mask[i];
+    }
+
+    // Undo FP on the ciphertext and apply IP to the plaintext once, up front
+    state.permuted = permute64(IP_LUT, load_be64(params->plaintext));
+    state.target = permute64(IP_LUT, load_be64(params->ciphertext)); // IP = FP^-1
+
+    uint64_t total = (uint64_t)1 << state.free_count;
+    int threads = (params->threads > 0) ? params->threads : online_cores();
+    if ((uint64_t)threads > total)
+    {
+        threads = (int)total;
+    }
+
+    if (threads > KEYSEARCH_MAX_THREADS)
+    {
+        threads = KEYSEARCH_MAX_THREADS;
+    }
+    pthread_t handles[KEYSEARCH_MAX_THREADS];
+    keysearch_worker_t workers[KEYSEARCH_MAX_THREADS];
+
+    if (pthread_mutex_init(&state.lock, NULL) != 0)
+    {
+        perror("Error initialising key search");
+        return -1;
+    }
+
+    int started = 0;
+    for (int t = 0; t < threads; t++)
+    {
+        workers[t].state = &state;
+        workers[t].begin = total / threads * t;
+        workers[t].end = (t == threads - 1) ? total : total / threads * (t + 1);
+
+        pthread_mutex_lock(&state.lock);
+        state.running++;
+        pthread_mutex_unlock(&state.lock);
+
+        if (pthread_create(&handles[t], NULL, keysearch_worker, &workers[t]) != 0)
+        {
+            pthread_mutex_lock(&state.lock);
+            state.running--;
+            atomic_store_explicit(&state.found, -1, memory_order_relaxed); // Stop started workers
+            pthread_mutex_unlock(&state.lock);
+            break;
+        }
+        started++;
+    }
+
+    double start = now_seconds();
+    double last_report = start;
+    uint64_t last_tested = 0;
+
+    for (;;)
+    {
+        sleep_ms(KEYSEARCH_POLL_MS);
+
+        pthread_mutex_lock(&state.lock);
+        int running = state.running;
+        uint64_t tested = state.tested;
+        pthread_mutex_unlock(&state.lock);
+
+        double now = now_seconds();
+        if (params->progress && (now - last_report >= 1.0 || running == 0))
+        {
+            fprintf(stderr, "[keysearch] %llu / %llu keys (%.1f%%), %.2f Mkeys/s, %d thread(s)\n",
+                    (unsigned long long)tested, (unsigned long long)total,
+                    total ? 100.0 * (double)tested / (double)total : 100.0,
+                    (double)(tested - last_tested) / (now - last_report) / 1e6, started);
+            last_report = now;
+            last_tested = tested;
+        }
+        if (running == 0)
+        {
+            break;
+        }
+    }
+
+    for (int t = 0; t < started; t++)
+    {
+        pthread_join(handles[t], NULL);
+    }
+    pthread_mutex_destroy(&state.lock);
+
+    if (params->progress)
+    {
+        double elapsed = now_seconds() - start;
+        fprintf(stderr, "[keysearch] %llu keys in %.2f s (%.2f Mkeys/s average)\n",
+                (unsigned long long)state.tested, elapsed, (double)state.tested / elapsed / 1e6);
+    }
+
+    if (started < threads)
+    {
+        fprintf(stderr, "Error: Could not start key search threads\n");
+        return -1;
+    }
+    if (atomic_load_explicit(&state.found, memory_order_relaxed) == 1)
+    {
+        // Keep the caller's parity bits; they do not affect DES
+        for (int i = 0; i < 8; i++)
+        {
+            found_key[i] = (uint8_t)((state.found_key[i] & 0xFE) | (params->base_key[i] & 0x01));
+        }
+        return 1;
+    }
+    return 0;
+}
@@ -6,6 +6,55 @@
 #include "file_io.h"
 #include "des.h"
 #include "help.h"
+#include "keysearch.h"
+
+// Validate a 16-character hexadecimal block argument and convert it to bytes
+static int parse_hex_block(const char *name, const char *hex, uint8_t *bytes)
+{
+    if (!hex || strlen(hex) != 16 || strspn(hex, "0123456789abcdefABCDEF") != 16)
+    {
+        printf("Error: %s must be a 16-character hexadecimal string\n", name);
+        return 0;
+    }
+    hex_to_bytes(hex, bytes);
+    return 1;
+}
+
+// Run --keysearch: find the key bits under 'mask' that map plaintext to ciphertext
+static int run_keysearch(const char *plaintext, const char *ciphertext, const char *key,
+                         const char *mask, int threads)
+{
+    keysearch_params_t params = {0};
+
+    if (!parse_hex_block("Plaintext", plaintext, params.plaintext) ||
+        !parse_hex_block("Ciphertext", ciphertext, params.ciphertext) ||
+        !parse_hex_block("Mask", mask, params.mask) ||
+        (key && !parse_hex_block("Key", key, params.base_key)))
+    {
+        print_usage();
+        return EXIT_FAILURE;
+    }
+    params.threads = threads;
+    params.progress = 1;
+
+    uint8_t found_key[8];
+    int result = des_keysearch(&params, found_key);
+    if (result == 1)
+    {
+        printf("Key found: ");
+        for (int i = 0; i < 8; i++)
+        {
+            printf("%02X", found_key[i]);
+        }
+        printf("\n");
+        return EXIT_SUCCESS;
+    }
+    if (result == 0)
+    {
+        printf("No key in the masked keyspace maps the plaintext to the ciphertext.\n");
+    }
+    return EXIT_FAILURE;
+}
 
 int main(int argc, char *argv[])
 {
@@ -14,17 +63,29 @@ int main(int argc, char *argv[])
     char *key = NULL;
     char *keyfile = NULL;
     int mode_value = -1;
+    output_policy_t output_policy = OUTPUT_POLICY_OVERWRITE;
+    int keysearch = 0;
+    char *plaintext = NULL;
+    char *ciphertext = NULL;
+    char *mask = NULL;
+    int threads = 0;
 
     // Define long options
     static struct option long_options[] = {
         {"mode", required_argument, 0, 'm'},
         {"key", required_argument, 0, 'k'},
         {"keyfile", required_argument, 0, 'f'},
+        {"output-policy", required_argument, 0, 'p'},
+        {"keysearch", no_argument, 0, 's'},
+        {"plaintext", required_argument, 0, 'P'},
+        {"ciphertext", required_argument, 0, 'C'},
+        {"mask", required_argument, 0, 'M'},
+        {"threads", required_argument, 0, 't'},
         {"help", no_argument, 0, 'h'},
         {0, 0, 0, 0}};
 
     // Parse command-line options
-    while ((opt = getopt_long(argc, argv, "m:k:f:h", long_options, NULL)) != -1)
+    while ((opt = getopt_long(argc, argv, "m:k:f:p:sP:C:M:t:h", long_options, NULL)) != -1)
     {
         switch (opt)
         {
@@ -50,6 +111,29 @@ int main(int argc, char *argv[])
         case 'f':
             keyfile = optarg; // Key as file (binary or hex)
             break;
+        case 'p':
+            if (!parse_output_policy(optarg, &output_policy))
+            {
+                printf("Error: Unknown output policy '%s'\n", optarg);
+                print_usage();
+                return EXIT_FAILURE;
+            }
+            break;
+        case 's':
+            keysearch = 1;
+            break;
+        case 'P':
+            plaintext = optarg; // Known plaintext block (hex)
+            break;
+        case 'C':
+            ciphertext = optarg; // Matching ciphertext block (hex)
+            break;
+        case 'M':
+            mask = optarg; // Unknown key bits (hex)
+            break;
+        case 't':
+            threads = atoi(optarg);
+            break;
         case 'h':
             print_usage();
             return EXIT_SUCCESS;
@@ -60,6 +144,12 @@ int main(int argc, char *argv[])
         }
     }
 
+    // Key search mode works on a single known block and takes no files
+    if (keysearch)
+    {
+        return run_keysearch(plaintext, ciphertext, key, mask, threads);
+    }
+
     // Check if enough arguments are remaining
     if (optind + 2 != argc)
     {
@@ -112,26 +202,12 @@ int main(int argc, char *argv[])
         return EXIT_FAILURE;
     }
 
-    // Handle the output file for encryption
-    if (mode_value == 1)
+    // Process the files for encryption or decryption with padding handling
+    if (!process_files(input_file, output_file, des_key, mode_value, output_policy))
     {
-        int append = handle_ciphertext_file(output_file);
-        if (append == 0)
-        {
-            // Clear file contents before writing if the user chose 'c'
-            FILE *out = fopen(output_file, "wb");
-            if (!out)
-            {
-                perror("Error opening output file");
-                return EXIT_FAILURE;
-            }
-            fclose(out);
-        }
+        return EXIT_FAILURE;
     }
 
-    // Process the files for encryption or decryption with padding handling
-    process_files(input_file, output_file, des_key, mode_value);
-
     printf("%s successful!\n", (mode_value == 1) ? "Encryption" : "Decryption");
     return EXIT_SUCCESS;
 }
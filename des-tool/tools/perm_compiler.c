@@ -0,0 +1,108 @@
+/**
+ * @file perm_compiler.c
+ * @brief Compiles the DES permutation tables into byte-indexed lookup tables.
+ *
+ * Run at build time; writes the C definitions declared in des_perm_luts.h to
+ * stdout. Each output bit i taken from input bit t sets bit (63 - i) in every
+ * LUT[t / 8][v] whose byte value v has that bit set, so a permutation becomes
+ * one lookup and OR per input byte.
+ *
+ * It also folds the P permutation into the S-boxes (the SP tables), so a
+ * Feistel round is eight lookups and ORs on 32-bit words.
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include "des_tables.h"
+
+// Build the LUT for a permutation table of 'size' output bits
+static void compile_permutation(const int *table, int size, uint64_t lut[8][256])
+{
+    memset(lut, 0, 8 * 256 * sizeof(uint64_t));
+
+    for (int i = 0; i < size; i++)
+    {
+        int byte_index = (table[i] - 1) / 8;
+        int bit_mask = 1 << (7 - (table[i] - 1) % 8);
+
+        for (int v = 0; v < 256; v++)
+        {
+            if (v & bit_mask)
+            {
+                lut[byte_index][v] |= (uint64_t)1 << (63 - i);
+            }
+        }
+    }
+}
+
+// Emit one LUT as a C array definition
+static void emit_lut(const char *name, const int *table, int size, int in_bytes)
+{
+    uint64_t lut[8][256];
+    compile_permutation(table, size, lut);
+
+    printf("const uint64_t %s[%d][256] = {\n", name, in_bytes);
+    for (int b = 0; b < in_bytes; b++)
+    {
+        printf("    {\n");
+        for (int v = 0; v < 256; v += 4)
+        {
+            printf("        0x%016llXULL, 0x%016llXULL, 0x%016llXULL, 0x%016llXULL,\n",
+                   (unsigned long long)lut[b][v], (unsigned long long)lut[b][v + 1],
+                   (unsigned long long)lut[b][v + 2], (unsigned long long)lut[b][v + 3]);
+        }
+        printf("    },\n");
+    }
+    printf("};\n\n");
+}
+
+// Emit SP_LUT[box][x]: S-box 'box' applied to the 6-bit input x, then P, as a 32-bit word
+static void emit_sp_lut(void)
+{
+    uint64_t p_lut[8][256];
+    compile_permutation(P_TABLE, 32, p_lut);
+
+    printf("const uint32_t SP_LUT[8][64] = {\n");
+    for (int box = 0; box < 8; box++)
+    {
+        printf("    {\n");
+        for (int x = 0; x < 64; x += 4)
+        {
+            printf("       ");
+            for (int k = 0; k < 4; k++)
+            {
+                int v = x + k;
+                int row = ((v >> 4) & 0x02) | (v & 0x01);
+                int col = (v >> 1) & 0x0F;
+
+                // S-box output occupies bits 4*box+1..4*box+4 of the 32-bit P input
+                uint32_t sbox_out = (uint32_t)S_BOX[box][row][col] << (28 - 4 * box);
+                uint64_t permuted = 0;
+                for (int b = 0; b < 4; b++)
+                {
+                    permuted |= p_lut[b][(sbox_out >> (24 - 8 * b)) & 0xFF];
+                }
+                printf(" 0x%08lXUL,", (unsigned long)(permuted >> 32));
+            }
+            printf("\n");
+        }
+        printf("    },\n");
+    }
+    printf("};\n");
+}
+
+int main(void)
+{
+    printf("/* Generated by tools/perm_compiler.c from des_tables.c. Do not edit. */\n\n");
+    printf("#include \"des_perm_luts.h\"\n\n");
+
+    emit_lut("IP_LUT", IP_TABLE, 64, 8);
+    emit_lut("FP_LUT", FP_TABLE, 64, 8);
+    emit_lut("PC1_LUT", PC1, 56, 8);
+    emit_lut("PC2_LUT", PC2, 48, 7);
+    emit_lut("E_LUT", E_TABLE, 48, 4);
+    emit_lut("P_LUT", P_TABLE, 32, 4);
+    emit_sp_lut();
+    return 0;
+}
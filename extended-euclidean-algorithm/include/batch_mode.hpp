@@ -0,0 +1,51 @@
+#ifndef BATCH_MODE_HPP
+#define BATCH_MODE_HPP
+
+#include <cstddef>
+#include <iostream>
+#include <string>
+#include "gcd_engine.hpp"
+
+/**
+ * @brief Output formats of the batch mode.
+ */
+enum class BatchFormat
+{
+    Csv, ///< Header line, then x,y,gcd,inverse,bezout_x,bezout_y,error per pair
+    Json ///< One JSON object per line (JSON Lines)
+};
+
+/**
+ * @brief Settings of a batch run, as given on the command line.
+ */
+struct BatchOptions
+{
+    GcdEngine engine = GcdEngine::Euclidean; ///< Algorithm for the inverse (see run_batch())
+    BatchFormat format = BatchFormat::Csv;   ///< Output format
+    std::size_t threads = 0;                 ///< Worker threads (0 = all cores)
+};
+
+/**
+ * @brief Processes (x, y) pairs from a stream and writes one result per pair.
+ *
+ * Each input line holds two integers (decimal or 0x-prefixed hex, optionally negative,
+ * up to 4096 bits) separated by spaces, tabs or commas. Blank lines and lines starting
+ * with '#' are skipped. For each pair the GCD, the Bézout coefficients
+ * (x * bezout_x + y * bezout_y = gcd) and the inverse of x modulo y (-1 if none exists)
+ * are written, in input order. A line that cannot be processed yields a record with an
+ * error message instead; y must be positive.
+ *
+ * The inverse is computed with options.engine. The Bézout coefficients use the Lehmer
+ * engine when it is selected and the Euclidean engine otherwise.
+ *
+ * Input is read in blocks of lines; the worker threads evaluate each block and its
+ * results are written before the next block is read.
+ *
+ * @param[in] in The input stream.
+ * @param[in] out The output stream.
+ * @param[in] options The engine, format and thread count.
+ * @return The number of lines that failed.
+ */
+std::size_t run_batch(std::istream &in, std::ostream &out, const BatchOptions &options);
+
+#endif // BATCH_MODE_HPP
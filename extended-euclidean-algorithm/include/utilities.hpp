@@ -1,6 +1,13 @@
 #ifndef UTILITIES_HPP
 #define UTILITIES_HPP
 
+#include "big_int.hpp"
+
+/**
+ * @brief Integer type used by the interactive calculator (signed, 4096-bit magnitude).
+ */
+using Integer = Int4096;
+
 /**
  * @brief Displays a welcome message for the GCD and Modular Inverse Calculator.
  *
@@ -12,14 +19,15 @@ void display_welcome_message();
 /**
  * @brief Prompts the user for two positive integers and stores them in the provided references.
  *
- * This function prompts the user to enter two positive integers and performs basic
- * validation. If the input is invalid, it displays an error message and re-prompts
- * the user until valid input is received.
+ * This function prompts the user to enter two positive integers (decimal or 0x-prefixed hex,
+ * up to 4096 bits) and performs basic validation. If the input is invalid, it displays an
+ * error message and re-prompts the user until valid input is received.
  *
  * @param[out] x Reference to the first integer input by the user.
  * @param[out] y Reference to the second integer input by the user.
+ * @return false if standard input ended before valid input was read.
  */
-void prompt_user_for_input(int &x, int &y);
+bool prompt_user_for_input(Integer &x, Integer &y);
 
 /**
  * @brief Displays the results of the GCD and modular inverse calculations.
@@ -31,7 +39,8 @@ void prompt_user_for_input(int &x, int &y);
  * @param[in] gcd_val The calculated GCD of x and y.
  * @param[in] inverse The modular inverse of x modulo y, or -1 if it does not exist.
  */
-void display_results(int x, int y, int gcd_val, int inverse);
+void display_results(const Integer &x, const Integer &y, const Integer &gcd_val,
+                     const Integer &inverse);
 
 /**
  * @brief Asks the user if they want to perform another calculation.
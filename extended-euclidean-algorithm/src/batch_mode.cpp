@@ -0,0 +1,183 @@
+// batch_mode.cpp
+
+#include <algorithm>
+#include <exception>
+#include <string>
+#include <string_view>
+#include "batch_mode.hpp"
+#include "big_int.hpp"
+#include "line_batch.hpp"
+
+using namespace std;
+
+namespace
+{
+
+// Smallest share of a block worth its own thread
+const size_t LINES_PER_THREAD = 64;
+
+// Result of one input line, already formatted in decimal
+struct PairResult
+{
+    string x, y, gcd, inverse, bezout_x, bezout_y;
+    string error; // Non-empty if the line failed; the fields above may then be partial
+};
+
+string to_decimal(long long value)
+{
+    return to_string(value);
+}
+
+template <size_t Limbs>
+string to_decimal(const BigInt<Limbs> &value)
+{
+    return value.toString();
+}
+
+// Extended GCD and inverse for one pair, in whichever integer type holds it. The Bézout
+// coefficients come from the Euclidean or Lehmer engine; the binary and safegcd engines
+// compute the inverse themselves, so it is not derived from the coefficients then.
+template <typename T>
+void solve(const T &x, const T &y, GcdEngine engine, PairResult &result)
+{
+    ExtendedGcdResult<T> bezout = extended_gcd(x, y, engine);
+    bool own_inverse = engine == GcdEngine::Binary || engine == GcdEngine::SafeGcd;
+    result.x = to_decimal(x);
+    result.y = to_decimal(y);
+    result.gcd = to_decimal(bezout.gcd);
+    if (own_inverse && bezout.gcd == T(1))
+        result.inverse = to_decimal(mod_inverse(x, y, engine));
+    else
+        result.inverse = to_decimal(inverse_from_bezout(bezout, y));
+    result.bezout_x = to_decimal(bezout.x);
+    result.bezout_y = to_decimal(bezout.y);
+}
+
+// Multi-limb path with the narrowest BigInt that holds both operands
+template <size_t Limbs>
+void solve_big(const Int4096 &x, const Int4096 &y, GcdEngine engine, PairResult &result)
+{
+    BigInt<Limbs> narrow_x(x.magnitude().resize<Limbs>(), x.isNegative());
+    BigInt<Limbs> narrow_y(y.magnitude().resize<Limbs>(), y.isNegative());
+    solve(narrow_x, narrow_y, engine, result);
+}
+
+// Evaluate one pair; throws std::exception subclasses for invalid input
+void evaluate(string_view x_text, string_view y_text, GcdEngine engine, PairResult &result)
+{
+    long long small_x = 0;
+    long long small_y = 0;
+    if (parseWord(x_text, true, small_x) && parseWord(y_text, true, small_y))
+    {
+        if (small_y <= 0)
+            throw invalid_argument("y must be positive");
+        solve(small_x, small_y, engine, result);
+        return;
+    }
+
+    Int4096 x = Int4096::fromString(string(x_text));
+    Int4096 y = Int4096::fromString(string(y_text));
+    if (y <= Int4096(0))
+        throw invalid_argument("y must be positive");
+    size_t bits = max(x.magnitude().bitLength(), y.magnitude().bitLength());
+    if (bits <= 512)
+        solve_big<8>(x, y, engine, result);
+    else if (bits <= 1024)
+        solve_big<16>(x, y, engine, result);
+    else if (bits <= 2048)
+        solve_big<32>(x, y, engine, result);
+    else
+        solve_big<64>(x, y, engine, result);
+}
+
+// Turn one input line into its result; false for lines without a pair
+bool process_line(string_view line, GcdEngine engine, PairResult &result)
+{
+    // A third field only flags an error
+    string_view tokens[3];
+    size_t count = splitFields(line, tokens, 3);
+    if (count == 0)
+        return false;
+
+    result.x = string(tokens[0]);
+    result.y = count > 1 ? string(tokens[1]) : string();
+    if (count != 2)
+    {
+        result.error = "expected 2 numbers (x y), got " + to_string(count);
+        return true;
+    }
+    try
+    {
+        evaluate(tokens[0], tokens[1], engine, result);
+    }
+    catch (const exception &e)
+    {
+        result.error = e.what();
+    }
+    return true;
+}
+
+// Quote a field for CSV or JSON, doubling ('"' -> '""') or escaping ('"' -> '\"') quotes
+string quote(const string &text, bool json)
+{
+    string quoted = "\"";
+    for (char c : text)
+    {
+        if (c == '"')
+            quoted += json ? "\\\"" : "\"\"";
+        else if (c == '\\' && json)
+            quoted += "\\\\";
+        else if (static_cast<unsigned char>(c) < 0x20 && json)
+            quoted += ' ';
+        else
+            quoted += c;
+    }
+    return quoted + "\"";
+}
+
+void write_result(ostream &out, const PairResult &r, BatchFormat format)
+{
+    if (format == BatchFormat::Csv)
+    {
+        if (r.error.empty())
+            out << r.x << ',' << r.y << ',' << r.gcd << ',' << r.inverse << ',' << r.bezout_x
+                << ',' << r.bezout_y << ",\n";
+        else
+            out << quote(r.x, false) << ',' << quote(r.y, false) << ",,,,,"
+                << quote(r.error, false) << '\n';
+    }
+    else if (r.error.empty())
+    {
+        out << "{\"x\": " << r.x << ", \"y\": " << r.y << ", \"gcd\": " << r.gcd
+            << ", \"inverse\": " << r.inverse << ", \"bezout_x\": " << r.bezout_x
+            << ", \"bezout_y\": " << r.bezout_y << "}\n";
+    }
+    else
+    {
+        out << "{\"x\": " << quote(r.x, true) << ", \"y\": " << quote(r.y, true)
+            << ", \"error\": " << quote(r.error, true) << "}\n";
+    }
+}
+
+} // namespace
+
+size_t run_batch(istream &in, ostream &out, const BatchOptions &options)
+{
+    if (options.format == BatchFormat::Csv)
+        out << "x,y,gcd,inverse,bezout_x,bezout_y,error\n";
+
+    auto make_worker = [&]()
+    {
+        return [&](string_view line, PairResult &result)
+        { return process_line(line, options.engine, result); };
+    };
+    auto write = [&](const PairResult &result)
+    {
+        write_result(out, result, options.format);
+        return result.error.empty();
+    };
+    size_t failures =
+        processLineStream<PairResult>(in, LINES_PER_THREAD, options.threads, make_worker, write);
+    out.flush();
+    return failures;
+}
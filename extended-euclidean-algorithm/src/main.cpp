@@ -1,26 +1,50 @@
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <getopt.h>
 #include <iostream>
-#include "gcd.hpp"
-#include "mod_inverse.hpp"
+#include "batch_mode.hpp"
+#include "gcd_engine.hpp"
 #include "utilities.hpp"
 
 using namespace std;
 
-int main()
+static void print_usage(const char *program)
 {
-    int x, y;
+    cout << "Usage: " << program << " [options]\n"
+         << "\n"
+         << "Without --batch, runs the interactive calculator. With --batch, reads (x, y) pairs\n"
+         << "one per line from --file or standard input and writes x, y, the GCD, the inverse\n"
+         << "of x modulo y (-1 if none) and the Bezout coefficients of each pair, in order.\n"
+         << "The inverse uses the selected engine; the Bezout coefficients come from the\n"
+         << "Lehmer engine with --engine lehmer and from the Euclidean one otherwise.\n"
+         << "\n"
+         << "Options:\n"
+         << "  -e, --engine NAME    euclidean (default), binary, lehmer or safegcd\n"
+         << "  -b, --batch          Non-interactive batch mode\n"
+         << "  -f, --file FILE      Read pairs from FILE ('-' for standard input); implies --batch\n"
+         << "  -o, --format FORMAT  csv (default) or json (one object per line)\n"
+         << "  -t, --threads N      Worker threads for --batch (default: all cores)\n"
+         << "  -h, --help           Show this help\n";
+}
+
+static int run_interactive(GcdEngine engine)
+{
+    Integer x, y;
 
     display_welcome_message();
 
     do
     {
         // Prompt user for input
-        prompt_user_for_input(x, y);
+        if (!prompt_user_for_input(x, y))
+            break;
 
         // Compute GCD
-        int gcd_val = gcd(x, y);
+        Integer gcd_val = gcd(x, y, engine);
 
         // Compute Modular Inverse if GCD is 1
-        int inverse = (gcd_val == 1) ? mod_inverse(x, y) : -1;
+        Integer inverse = (gcd_val == Integer(1)) ? mod_inverse(x, y, engine) : Integer(-1);
 
         // Display results
         display_results(x, y, gcd_val, inverse);
@@ -30,3 +54,99 @@ int main()
     cout << "Thank you for using the calculator. Goodbye!\n";
     return 0;
 }
+
+int main(int argc, char *argv[])
+{
+    BatchOptions options;
+    bool batch = false;
+    const char *file = nullptr;
+
+    static struct option long_options[] = {
+        {"engine", required_argument, 0, 'e'},
+        {"batch", no_argument, 0, 'b'},
+        {"file", required_argument, 0, 'f'},
+        {"format", required_argument, 0, 'o'},
+        {"threads", required_argument, 0, 't'},
+        {"help", no_argument, 0, 'h'},
+        {0, 0, 0, 0}};
+
+    int opt;
+    while ((opt = getopt_long(argc, argv, "e:bf:o:t:h", long_options, NULL)) != -1)
+    {
+        switch (opt)
+        {
+        case 'e':
+            if (!parse_gcd_engine(optarg, options.engine))
+            {
+                cerr << "Error: unknown engine '" << optarg << "'" << endl;
+                return EXIT_FAILURE;
+            }
+            break;
+        case 'b':
+            batch = true;
+            break;
+        case 'f':
+            batch = true;
+            file = optarg;
+            break;
+        case 'o':
+            if (strcmp(optarg, "csv") == 0)
+                options.format = BatchFormat::Csv;
+            else if (strcmp(optarg, "json") == 0)
+                options.format = BatchFormat::Json;
+            else
+            {
+                cerr << "Error: unknown format '" << optarg << "'" << endl;
+                return EXIT_FAILURE;
+            }
+            break;
+        case 't':
+            options.threads = strtoul(optarg, nullptr, 10);
+            if (options.threads < 1)
+            {
+                cerr << "Error: thread count must be positive" << endl;
+                return EXIT_FAILURE;
+            }
+            break;
+        case 'h':
+            print_usage(argv[0]);
+            return EXIT_SUCCESS;
+        default:
+            print_usage(argv[0]);
+            return EXIT_FAILURE;
+        }
+    }
+    if (optind < argc)
+    {
+        cerr << "Error: unexpected argument '" << argv[optind] << "'" << endl;
+        print_usage(argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    if (!batch)
+        return run_interactive(options.engine);
+
+    ios::sync_with_stdio(false);
+    size_t failures = 0;
+    if (file && strcmp(file, "-") != 0)
+    {
+        ifstream in(file);
+        if (!in)
+        {
+            cerr << "Error: cannot open '" << file << "'" << endl;
+            return EXIT_FAILURE;
+        }
+        failures = run_batch(in, cout, options);
+    }
+    else
+    {
+        failures = run_batch(cin, cout, options);
+    }
+
+    if (failures > 0)
+    {
+        cerr << failures << " pair(s) failed" << endl;
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
@@ -1,6 +1,8 @@
 // utilities.cpp
 
 #include <iostream>
+#include <stdexcept>
+#include <string>
 #include "utilities.hpp"
 
 using namespace std;
@@ -14,46 +16,62 @@ void display_welcome_message()
     cout << RESET;
 }
 
-void prompt_user_for_input(int &x, int &y)
+bool prompt_user_for_input(Integer &x, Integer &y)
 {
     cout << CYAN << BOLD << "\n==================== Input Required ====================\n"
          << RESET;
-    do
+    while (true)
     {
         cout << YELLOW;
         cout << "\nPlease enter two positive integers separated by a space.\n";
         cout << "Example: To compute GCD and modular inverse of 3 modulo 7, enter: 3 7\n\n";
         cout << "Enter values for x and y: " << RESET;
-        cin >> x >> y;
 
-        if (x <= 0 || y <= 0)
+        string x_text, y_text;
+        if (!(cin >> x_text >> y_text))
+            return false;
+
+        try
+        {
+            x = Integer::fromString(x_text);
+            y = Integer::fromString(y_text);
+            if (x > Integer(0) && y > Integer(0))
+                return true;
+        }
+        catch (const exception &)
         {
-            cout << RED << BOLD;
-            cout << "\nError: Both x and y must be positive integers greater than zero.\n";
-            cout << "------------------------------------------------------------------\n"
-                 << RESET;
+            // Fall through to the error message below
         }
-    } while (x <= 0 || y <= 0);
+
+        cout << RED << BOLD;
+        cout << "\nError: Both x and y must be positive integers greater than zero.\n";
+        cout << "------------------------------------------------------------------\n"
+             << RESET;
+    }
 }
 
-void display_results(int x, int y, int gcd_val, int inverse)
+void display_results(const Integer &x, const Integer &y, const Integer &gcd_val,
+                     const Integer &inverse)
 {
     cout << GREEN << BOLD;
     cout << "\n==================== Calculation Results ====================\n"
          << RESET;
-    cout << MAGENTA << "GCD(" << x << ", " << y << ") = " << gcd_val << "\n"
+    cout << MAGENTA << "GCD(" << x.toString() << ", " << y.toString() << ") = "
+         << gcd_val.toString() << "\n"
          << RESET;
 
-    if (inverse != -1)
+    if (inverse != Integer(-1))
     {
         cout << MAGENTA;
-        cout << "Modular Inverse of " << x << " modulo " << y << " is " << inverse << "\n"
+        cout << "Modular Inverse of " << x.toString() << " modulo " << y.toString() << " is "
+             << inverse.toString() << "\n"
              << RESET;
     }
     else
     {
         cout << RED << BOLD;
-        cout << "Modular Inverse does not exist since GCD(" << x << ", " << y << ") != 1.\n"
+        cout << "Modular Inverse does not exist since GCD(" << x.toString() << ", "
+             << y.toString() << ") != 1.\n"
              << RESET;
     }
     cout << GREEN << BOLD << "=============================================================\n"
@@ -0,0 +1,235 @@
+/**
+ * @file gcd_bench.cpp
+ * @brief Throughput benchmark for the GCD engines (run with `make bench`).
+ *
+ * Usage: gcd_bench [--format csv|json] [--max-bits <bits>]
+ *
+ * For each operand width (int32_t, int64_t, __int128, then BigInt at 512 bits
+ * and up) a pool of random full-size operand pairs is fixed, and every engine
+ * runs gcd() and mod_inverse() over the same pool (Lehmer only for the BigInt
+ * widths, safegcd for inverses only). Inverses use an odd modulus, which is
+ * the case the binary engine handles itself. mod_inverse_batch() then inverts
+ * the whole pool, adjusted to be coprime to one of those moduli as with a
+ * prime modulus, and its rate is reported per element.
+ *
+ * Finally every inverse engine runs modulo a single random (probable) prime of
+ * the same width, against mod_inverse() with ModulusHint::Prime, which takes
+ * the Montgomery-based Fermat inverse ("fermat" rows of mod_inverse_prime).
+ *
+ * Before timing, each engine's results are cross-checked against the
+ * Euclidean engine's. Any mismatch is reported and makes the benchmark exit
+ * non-zero.
+ */
+
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+#include "batch_inverse.hpp"
+#include "bench_harness.hpp"
+#include "gcd_engine.hpp"
+
+using namespace std;
+
+namespace
+{
+
+// Operand pairs cycled through by each measurement
+const size_t POOL_SIZE = 64;
+
+// A row is verified when the engine agreed with the Euclidean engine on the whole pool
+BenchReport report({"operation", "engine"});
+size_t mismatches = 0;
+
+mt19937_64 rng(0x5eed);
+
+// Low word of a result, folded into the sink
+template <typename T>
+uint64_t low_word(const T &value)
+{
+    return static_cast<uint64_t>(value);
+}
+
+template <size_t Limbs>
+uint64_t low_word(const BigInt<Limbs> &value)
+{
+    return value.magnitude()[0];
+}
+
+// Random positive value of exactly bits bits (bits below the type's sign bit)
+template <typename T>
+T random_value(size_t bits)
+{
+    unsigned __int128 value = (static_cast<unsigned __int128>(rng()) << 64) | rng();
+    value &= (static_cast<unsigned __int128>(1) << (bits - 1)) - 1;
+    value |= static_cast<unsigned __int128>(1) << (bits - 1);
+    return static_cast<T>(value);
+}
+
+template <size_t Limbs>
+BigInt<Limbs> random_big(size_t)
+{
+    BigUInt<Limbs> value;
+    for (size_t i = 0; i < Limbs; ++i)
+        value[i] = rng();
+    value[Limbs - 1] |= uint64_t(1) << 63;
+    return BigInt<Limbs>(value);
+}
+
+// Cross-check one engine (labelled name) against the reference results, then time it
+template <typename T, class Op>
+void bench_engine(size_t bits, const string &operation, const string &name, const vector<T> &a,
+                  const vector<T> &b, vector<T> &reference, Op op)
+{
+    bool verified = true;
+    for (size_t i = 0; i < POOL_SIZE; ++i)
+    {
+        T r = op(a[i], b[i]);
+        if (reference.size() < POOL_SIZE)
+            reference.push_back(r);
+        else if (r != reference[i])
+            verified = false;
+    }
+    if (!verified)
+    {
+        mismatches++;
+        cerr << "MISMATCH: " << name << " " << operation << " at " << bits << " bits" << endl;
+    }
+
+    auto timing =
+        benchLoop(POOL_SIZE, [&](size_t i) { benchSink = benchSink + low_word(op(a[i], b[i])); });
+    report.add(bits, {operation, name}, timing.first, timing.second, verified);
+}
+
+// Cross-check mod_inverse_batch() (one thread) against mod_inverse() modulo m, then time it
+template <typename T>
+void bench_batch(size_t bits, GcdEngine engine, vector<T> a, const T &m)
+{
+    // Every element invertible, as with a prime modulus
+    for (T &x : a)
+        while (gcd(x, m) != T(1))
+            x = x + T(1);
+
+    vector<T> out = mod_inverse_batch(a, m, 1, engine);
+    bool verified = true;
+    for (size_t i = 0; i < POOL_SIZE; ++i)
+        verified = verified && out[i] == mod_inverse(a[i], m);
+    if (!verified)
+    {
+        mismatches++;
+        cerr << "MISMATCH: " << gcd_engine_name(engine) << " mod_inverse_batch at " << bits
+             << " bits" << endl;
+    }
+
+    // Each call inverts the whole pool; count its elements as operations
+    auto timing = benchLoop(1,
+                            [&](size_t)
+                            {
+                                mod_inverse_batch(a.data(), out.data(), POOL_SIZE, m, 1, engine);
+                                benchSink = benchSink + low_word(out[0]);
+                            });
+    report.add(bits, {"mod_inverse_batch", gcd_engine_name(engine)}, timing.first * POOL_SIZE,
+               timing.second, verified);
+}
+
+// Odd value of the given width that passes Fermat tests to bases 2 and 3; the Fermat
+// inverse of 2 (and 3) modulo p verifies exactly when 2^(p-1) ≡ 1 (and 3^(p-1) ≡ 1)
+template <typename T, class Random>
+T random_probable_prime(size_t bits, Random random)
+{
+    const int small_primes[] = {3, 5, 7, 11, 13, 17, 19, 23, 29, 31, 37, 41, 43, 47};
+    T p = random(bits);
+    if (p % T(2) == T(0))
+        p = p - T(1);
+    for (;; p = p - T(2))
+    {
+        bool composite = false;
+        for (int q : small_primes)
+            composite = composite || p % T(q) == T(0);
+        T inverse;
+        if (!composite && fermat_mod_inverse(T(2), p, inverse) &&
+            fermat_mod_inverse(T(3), p, inverse))
+            return p;
+    }
+}
+
+// Inverses modulo one prime: every engine without a hint, then the Fermat path
+template <typename T, class Random>
+void bench_prime(size_t bits, Random random, const vector<T> &a,
+                 const vector<GcdEngine> &engines)
+{
+    vector<T> p(POOL_SIZE, random_probable_prime<T>(bits, random));
+    vector<T> reference;
+    for (GcdEngine engine : engines)
+        bench_engine(bits, "mod_inverse_prime", gcd_engine_name(engine), a, p, reference,
+                     [engine](const T &x, const T &y) { return mod_inverse(x, y, engine); });
+    bench_engine(bits, "mod_inverse_prime", "fermat", a, p, reference,
+                 [](const T &x, const T &y)
+                 { return mod_inverse(x, y, GcdEngine::Euclidean, ModulusHint::Prime); });
+}
+
+template <typename T, class Random>
+void bench_width(size_t bits, Random random, const vector<GcdEngine> &gcd_engines,
+                 const vector<GcdEngine> &inverse_engines)
+{
+    vector<T> a;
+    vector<T> b;
+    for (size_t i = 0; i < POOL_SIZE; ++i)
+    {
+        a.push_back(random(bits));
+        T modulus = random(bits);
+        b.push_back(modulus % T(2) == T(0) ? modulus - T(1) : modulus);
+    }
+
+    vector<T> gcd_reference;
+    vector<T> inverse_reference;
+    for (GcdEngine engine : gcd_engines)
+        bench_engine(bits, "gcd", gcd_engine_name(engine), a, b, gcd_reference,
+                     [engine](const T &x, const T &y) { return gcd(x, y, engine); });
+    for (GcdEngine engine : inverse_engines)
+        bench_engine(bits, "mod_inverse", gcd_engine_name(engine), a, b, inverse_reference,
+                     [engine](const T &x, const T &y) { return mod_inverse(x, y, engine); });
+    bench_batch(bits, gcd_engines.back(), a, b[0]);
+    bench_prime(bits, random, a, inverse_engines);
+}
+
+} // namespace
+
+int main(int argc, char *argv[])
+{
+    BenchArgs args;
+    if (!parseBenchArgs(argc, argv, args))
+        return EXIT_FAILURE;
+
+    // Lehmer's algorithm only differs from the Euclidean one for multi-limb operands, and
+    // safegcd only computes inverses
+    const vector<GcdEngine> word_gcd = {GcdEngine::Euclidean, GcdEngine::Binary};
+    const vector<GcdEngine> word_inverse = {GcdEngine::Euclidean, GcdEngine::Binary,
+                                            GcdEngine::SafeGcd};
+    const vector<GcdEngine> big_gcd = {GcdEngine::Euclidean, GcdEngine::Binary,
+                                       GcdEngine::Lehmer};
+    const vector<GcdEngine> big_inverse = {GcdEngine::Euclidean, GcdEngine::Binary,
+                                           GcdEngine::Lehmer, GcdEngine::SafeGcd};
+    bench_width<int32_t>(31, random_value<int32_t>, word_gcd, word_inverse);
+    bench_width<int64_t>(63, random_value<int64_t>, word_gcd, word_inverse);
+    bench_width<__int128>(127, random_value<__int128>, word_gcd, word_inverse);
+    if (args.maxBits >= 512)
+        bench_width<BigInt<8>>(512, random_big<8>, big_gcd, big_inverse);
+    if (args.maxBits >= 1024)
+        bench_width<BigInt<16>>(1024, random_big<16>, big_gcd, big_inverse);
+    if (args.maxBits >= 2048)
+        bench_width<BigInt<32>>(2048, random_big<32>, big_gcd, big_inverse);
+    if (args.maxBits >= 4096)
+        bench_width<BigInt<64>>(4096, random_big<64>, big_gcd, big_inverse);
+
+    report.print(cout, args.json);
+
+    if (mismatches > 0)
+    {
+        cerr << mismatches << " engine(s) disagreed with the Euclidean engine" << endl;
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
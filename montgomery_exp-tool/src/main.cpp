@@ -1,21 +1,389 @@
+#include "batch_exp.hpp"
+#include "line_batch.hpp"
+#include "montgomery_big.hpp"
+#include "montgomery_context.hpp"
 #include "montgomery_exp.hpp"
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <getopt.h>
 #include <iostream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
 
-int main()
+namespace
 {
-    // Create an object of MontgomeryExp
-    MontgomeryExp montExp;
 
-    // Example values
-    long long a = 7;
-    long long b = 560;
-    long long n = 561;
+struct Options
+{
+    ExpEngine engine = ExpEngine::SlidingWindow;
+    std::size_t windowBits = 0;
+    std::size_t threads = 0;
+    bool stats = false;
+    bool hexOutput = false;
+};
+
+// Output line of one triple
+struct LineResult
+{
+    std::string output;
+    bool failed = false;
+};
+
+void printUsage(const char *program)
+{
+    std::cout << "Usage: " << program << " [options] [a b n]...\n"
+              << "\n"
+              << "Computes a^b mod n for each (a, b, n) triple. Triples come from the command\n"
+              << "line, or else one per line from --file or standard input. Numbers are decimal\n"
+              << "or 0x-prefixed hex, separated by spaces, tabs or commas; blank lines and lines\n"
+              << "starting with '#' are skipped. One output line is written per triple, in input\n"
+              << "order; a triple that cannot be computed yields 'error: <reason>'.\n"
+              << "\n"
+              << "When n fits in 63 bits the word engines are used (any positive n; a of any size\n"
+              << "or sign, reduced mod n first; exponent up to 4096 bits); otherwise the multi-limb\n"
+              << "engine is used (up to 4096 bits, odd n and non-negative a only).\n"
+              << "\n"
+              << "Options must come before the first triple. Put '--' in front of the triples when\n"
+              << "the first a is negative, e.g. " << program << " -- -3 5 7.\n"
+              << "\n"
+              << "Options:\n"
+              << "  -f, --file FILE      Read triples from FILE ('-' for standard input)\n"
+              << "  -e, --engine NAME    binary, fixed-window, sliding-window (default),\n"
+              << "                       montgomery-ladder or ct-fixed-window\n"
+              << "  -w, --window BITS    Window size for the windowed engines (1-"
+              << MAX_WINDOW_BITS << ", default automatic)\n"
+              << "  -t, --threads N      Worker threads (default: all cores)\n"
+              << "  -s, --stats          Append the ExpStats JSON of each triple after a tab\n"
+              << "  -x, --hex            Print results in hex\n"
+              << "  -h, --help           Show this help\n";
+}
+
+std::string formatSmall(long long value, bool hex)
+{
+    if (!hex)
+    {
+        return std::to_string(value);
+    }
+    static const char DIGITS[] = "0123456789abcdef";
+    char buffer[16];
+    std::size_t length = 0;
+    unsigned long long rest = static_cast<unsigned long long>(value);
+    do
+    {
+        buffer[length++] = DIGITS[rest & 0xF];
+        rest >>= 4;
+    } while (rest != 0);
+    std::string text = "0x";
+    while (length > 0)
+    {
+        text.push_back(buffer[--length]);
+    }
+    return text;
+}
+
+// Multi-limb path with the narrowest BigUInt that holds all three operands
+template <std::size_t Limbs>
+std::string computeBig(const UInt4096 &a, const UInt4096 &b, const UInt4096 &n,
+                       const Options &options, std::string &statsJson)
+{
+    BigMontgomeryExp<Limbs> exp;
+    exp.setEngine(options.engine, options.windowBits);
+    BigUInt<Limbs> result = exp.compute(a.resize<Limbs>(), b.resize<Limbs>(), n.resize<Limbs>());
+    if (options.stats)
+    {
+        statsJson = exp.getStats().toJson();
+    }
+    return options.hexOutput ? result.toHex() : result.toString();
+}
+
+// Word-sized a and n with an exponent past 63 bits: the word contexts take a BigUInt exponent
+template <std::size_t Limbs>
+std::string computeLongExponent(long long a, const UInt4096 &b, long long n, const Options &options,
+                                std::string &statsJson)
+{
+    if (n <= 0)
+    {
+        throw std::invalid_argument("modulus must be positive");
+    }
+    StatsTimer timer;
+    const BigUInt<Limbs> exponent = b.resize<Limbs>();
+    ExpStats stats = makeExpStats(options.engine, options.windowBits, exponent);
+
+    const std::uint64_t modulus = static_cast<std::uint64_t>(n);
+    long long reduced = a % n;
+    std::uint64_t base = static_cast<std::uint64_t>(reduced < 0 ? reduced + n : reduced);
+    std::uint64_t result = 0;
+    ExpCounters counters;
+    if (modulus & 1)
+    {
+        MontgomeryContext ctx(modulus);
+        result = ctx.fromMontgomery(exponentiate(ctx, ctx.toMontgomery(base), exponent,
+                                                 options.engine, options.windowBits, counters));
+    }
+    else
+    {
+        PlainModularContext ctx(modulus);
+        result = exponentiate(ctx, base, exponent, options.engine, options.windowBits, counters);
+    }
+    recordCounters(stats, counters, (modulus & 1) ? 2 : 0);
+    timer.stop(stats);
+    if (options.stats)
+    {
+        statsJson = stats.toJson();
+    }
+    return formatSmall(static_cast<long long>(result), options.hexOutput);
+}
+
+// Evaluate one triple; throws std::exception subclasses for invalid input
+std::string evaluate(std::string_view a, std::string_view b, std::string_view n,
+                     const Options &options, MontgomeryExp &exp)
+{
+    std::string statsJson;
+    std::string result;
+
+    if (!b.empty() && b[0] == '-')
+    {
+        throw std::invalid_argument("exponent must be non-negative");
+    }
+
+    // The word engines need only n to fit in 63 bits: a longer a is reduced mod n first,
+    // and the exponent may be longer
+    long long smallA = 0;
+    long long smallB = 0;
+    long long smallN = 0;
+    bool wordSized = parseWord(n, false, smallN);
+    if (wordSized && !parseWord(a, true, smallA))
+    {
+        if (smallN <= 0)
+        {
+            throw std::invalid_argument("modulus must be positive");
+        }
+        bool negative = !a.empty() && a[0] == '-';
+        UInt4096 magnitude = UInt4096::fromString(std::string(a.substr(negative ? 1 : 0)));
+        long long residue =
+            static_cast<long long>(magnitude.modSmall(static_cast<std::uint64_t>(smallN)));
+        smallA = negative ? -residue : residue;
+    }
+    if (wordSized && parseWord(b, false, smallB))
+    {
+        result = formatSmall(exp.compute(smallA, smallB, smallN), options.hexOutput);
+        if (options.stats)
+        {
+            statsJson = exp.getStats().toJson();
+        }
+    }
+    else if (wordSized)
+    {
+        UInt4096 bigB = UInt4096::fromString(std::string(b));
+        std::size_t bits = bigB.bitLength();
+        if (bits <= 512)
+        {
+            result = computeLongExponent<8>(smallA, bigB, smallN, options, statsJson);
+        }
+        else if (bits <= 1024)
+        {
+            result = computeLongExponent<16>(smallA, bigB, smallN, options, statsJson);
+        }
+        else if (bits <= 2048)
+        {
+            result = computeLongExponent<32>(smallA, bigB, smallN, options, statsJson);
+        }
+        else
+        {
+            result = computeLongExponent<64>(smallA, bigB, smallN, options, statsJson);
+        }
+    }
+    else
+    {
+        if (!a.empty() && a[0] == '-')
+        {
+            throw std::invalid_argument("negative bases need a modulus below 2^63");
+        }
+        UInt4096 bigA = UInt4096::fromString(std::string(a));
+        UInt4096 bigB = UInt4096::fromString(std::string(b));
+        UInt4096 bigN = UInt4096::fromString(std::string(n));
+        std::size_t bits = std::max({bigA.bitLength(), bigB.bitLength(), bigN.bitLength()});
+        if (bits <= 512)
+        {
+            result = computeBig<8>(bigA, bigB, bigN, options, statsJson);
+        }
+        else if (bits <= 1024)
+        {
+            result = computeBig<16>(bigA, bigB, bigN, options, statsJson);
+        }
+        else if (bits <= 2048)
+        {
+            result = computeBig<32>(bigA, bigB, bigN, options, statsJson);
+        }
+        else
+        {
+            result = computeBig<64>(bigA, bigB, bigN, options, statsJson);
+        }
+    }
+    return options.stats ? result + "\t" + statsJson : result;
+}
+
+// Turn one input line into its output line; false for lines without a triple
+bool processLine(std::string_view line, const Options &options, MontgomeryExp &exp,
+                 LineResult &result)
+{
+    // A fourth field only flags an error
+    std::string_view tokens[4];
+    std::size_t count = splitFields(line, tokens, 4);
+    if (count == 0)
+    {
+        return false;
+    }
+
+    if (count != 3)
+    {
+        result.output = "error: expected 3 numbers (a b n), got " + std::to_string(count);
+        result.failed = true;
+        return true;
+    }
+    try
+    {
+        result.output = evaluate(tokens[0], tokens[1], tokens[2], options, exp);
+    }
+    catch (const std::exception &e)
+    {
+        result.output = std::string("error: ") + e.what();
+        result.failed = true;
+    }
+    return true;
+}
+
+// Worker for processLineBlock(): one MontgomeryExp per thread
+auto makeWorker(const Options &options)
+{
+    return [&options]()
+    {
+        MontgomeryExp exp;
+        exp.setEngine(options.engine, options.windowBits);
+        return [&options, exp](std::string_view line, LineResult &result) mutable
+        { return processLine(line, options, exp, result); };
+    };
+}
+
+bool writeResult(const LineResult &result)
+{
+    std::cout << result.output << '\n';
+    return !result.failed;
+}
+
+} // namespace
+
+int main(int argc, char *argv[])
+{
+    std::ios::sync_with_stdio(false);
+
+    Options options;
+    const char *file = nullptr;
+
+    static struct option long_options[] = {
+        {"file", required_argument, 0, 'f'},
+        {"engine", required_argument, 0, 'e'},
+        {"window", required_argument, 0, 'w'},
+        {"threads", required_argument, 0, 't'},
+        {"stats", no_argument, 0, 's'},
+        {"hex", no_argument, 0, 'x'},
+        {"help", no_argument, 0, 'h'},
+        {0, 0, 0, 0}};
 
-    // Perform modular exponentiation
-    montExp.compute(a, b, n);
+    int opt;
+    // '+' stops at the first triple, so a negative a in a later triple is not taken for an option
+    while ((opt = getopt_long(argc, argv, "+f:e:w:t:sxh", long_options, NULL)) != -1)
+    {
+        switch (opt)
+        {
+        case 'f':
+            file = optarg;
+            break;
+        case 'e':
+            if (!parseExpEngine(optarg, options.engine))
+            {
+                std::cerr << "Error: unknown engine '" << optarg << "'" << std::endl;
+                printUsage(argv[0]);
+                return EXIT_FAILURE;
+            }
+            break;
+        case 'w':
+            options.windowBits = std::strtoul(optarg, nullptr, 10);
+            if (options.windowBits < 1 || options.windowBits > MAX_WINDOW_BITS)
+            {
+                std::cerr << "Error: window must be between 1 and " << MAX_WINDOW_BITS
+                          << std::endl;
+                return EXIT_FAILURE;
+            }
+            break;
+        case 't':
+            options.threads = std::strtoul(optarg, nullptr, 10);
+            if (options.threads < 1)
+            {
+                std::cerr << "Error: thread count must be positive" << std::endl;
+                return EXIT_FAILURE;
+            }
+            break;
+        case 's':
+            options.stats = true;
+            break;
+        case 'x':
+            options.hexOutput = true;
+            break;
+        case 'h':
+            printUsage(argv[0]);
+            return EXIT_SUCCESS;
+        default:
+            printUsage(argv[0]);
+            return EXIT_FAILURE;
+        }
+    }
 
-    // Print result and stats
-    montExp.printStats(a, b, n);
+    std::size_t failures = 0;
+    int positional = argc - optind;
+    if (positional > 0)
+    {
+        if (file || positional % 3 != 0)
+        {
+            std::cerr << "Error: give triples either as a multiple of 3 arguments or with --file"
+                      << std::endl;
+            printUsage(argv[0]);
+            return EXIT_FAILURE;
+        }
+        std::vector<std::string> lines;
+        for (int i = optind; i < argc; i += 3)
+        {
+            lines.push_back(std::string(argv[i]) + " " + argv[i + 1] + " " + argv[i + 2]);
+        }
+        failures = processLineBlock<LineResult>(lines, BATCH_MIN_PER_THREAD, options.threads,
+                                                makeWorker(options), writeResult);
+    }
+    else if (file && std::string(file) != "-")
+    {
+        std::ifstream in(file);
+        if (!in)
+        {
+            std::cerr << "Error: cannot open '" << file << "'" << std::endl;
+            return EXIT_FAILURE;
+        }
+        failures = processLineStream<LineResult>(in, BATCH_MIN_PER_THREAD, options.threads,
+                                                 makeWorker(options), writeResult);
+    }
+    else
+    {
+        failures = processLineStream<LineResult>(std::cin, BATCH_MIN_PER_THREAD,
+                                                 options.threads, makeWorker(options),
+                                                 writeResult);
+    }
 
-    return 0;
+    std::cout.flush();
+    if (failures > 0)
+    {
+        std::cerr << failures << " triple(s) failed" << std::endl;
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
 }
@@ -0,0 +1,214 @@
+/**
+ * @file exp_bench.cpp
+ * @brief Throughput benchmark for the exponentiation engines (run with `make bench`).
+ *
+ * Usage: exp_bench [--format csv|json] [--max-bits <bits>]
+ *
+ * For each operand size (32 and 63 bits, then 512 bits and up in multi-limb
+ * form) one random odd modulus of exactly that size is fixed and every engine
+ * exponentiates the same pool of full-size bases and exponents modulo it. The
+ * contexts are built once, outside the timed loop; each timed operation
+ * includes the conversions into and out of Montgomery form.
+ *
+ * "naive" is square-and-multiply with a '%' per product (PlainModularContext),
+ * which exists for the word-sized operands only. Before timing, every
+ * engine's results are cross-checked against the first engine's; any
+ * mismatch is reported and makes the benchmark exit non-zero.
+ */
+
+#include "bench_harness.hpp"
+#include "exp_engines.hpp"
+#include "montgomery_big.hpp"
+#include "montgomery_context.hpp"
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace
+{
+
+// Operand pairs cycled through by each measurement
+constexpr std::size_t POOL_SIZE = 32;
+
+// products_per_op: squarings plus multiplications per exponentiation
+BenchReport report({"engine"}, {"products_per_op"});
+std::size_t mismatches = 0;
+
+std::mt19937_64 rng(0x5eed);
+
+struct EngineCase
+{
+    const char *name;
+    ExpEngine engine;
+};
+
+const EngineCase ENGINES[] = {
+    {"binary", ExpEngine::Binary},
+    {"fixed-window", ExpEngine::FixedWindow},
+    {"sliding-window", ExpEngine::SlidingWindow},
+    {"montgomery-ladder", ExpEngine::Ladder},
+    {"ct-fixed-window", ExpEngine::ConstantTimeWindow},
+};
+
+// Low word of a result, folded into the sink
+std::uint64_t lowWord(std::uint64_t value)
+{
+    return value;
+}
+
+template <std::size_t Limbs>
+std::uint64_t lowWord(const BigUInt<Limbs> &value)
+{
+    return value[0];
+}
+
+// One exponentiation including the conversions, as MontgomeryExp::compute() does it
+template <class Context, class Exponent>
+typename Context::Value runOnce(const Context &ctx, const typename Context::Value &base,
+                                const Exponent &e, ExpEngine engine, ExpCounters &counters)
+{
+    return ctx.fromMontgomery(exponentiate(ctx, ctx.toMontgomery(base), e, engine, 0, counters));
+}
+
+// Cross-check against reference, then time one engine on one context
+template <class Context, class Exponent>
+void benchEngine(std::size_t bits, const std::string &name, const Context &ctx,
+                 ExpEngine engine, const std::vector<typename Context::Value> &bases,
+                 const std::vector<Exponent> &exps,
+                 std::vector<typename Context::Value> &reference)
+{
+    bool verified = true;
+    ExpCounters counters;
+    for (std::size_t i = 0; i < POOL_SIZE; ++i)
+    {
+        typename Context::Value r = runOnce(ctx, bases[i], exps[i], engine, counters);
+        if (reference.size() < POOL_SIZE)
+        {
+            reference.push_back(r);
+        }
+        else if (r != reference[i])
+        {
+            verified = false;
+        }
+    }
+    if (!verified)
+    {
+        mismatches++;
+        std::cerr << "MISMATCH: " << name << " at " << bits << " bits" << std::endl;
+    }
+
+    auto timing = benchLoop(POOL_SIZE,
+                            [&](std::size_t i)
+                            {
+                                ExpCounters scratch;
+                                benchSink = benchSink + lowWord(runOnce(ctx, bases[i], exps[i],
+                                                                        engine, scratch));
+                            });
+
+    double products = static_cast<double>(counters.squarings + counters.multiplications);
+    report.add(bits, {name}, timing.first, timing.second, verified, {products / POOL_SIZE});
+}
+
+void benchWords(std::size_t bits)
+{
+    std::uint64_t top = std::uint64_t(1) << (bits - 1);
+    std::uint64_t n = (rng() & (top - 1)) | top | 1;
+
+    std::vector<std::uint64_t> bases;
+    std::vector<std::uint64_t> exps;
+    for (std::size_t i = 0; i < POOL_SIZE; ++i)
+    {
+        bases.push_back(rng() % n);
+        exps.push_back((rng() & (top - 1)) | top);
+    }
+
+    std::vector<std::uint64_t> reference;
+    PlainModularContext plain(n);
+    benchEngine(bits, "naive", plain, ExpEngine::Binary, bases, exps, reference);
+
+    MontgomeryContext mont(n);
+    for (const EngineCase &c : ENGINES)
+    {
+        benchEngine(bits, std::string("redc-") + c.name, mont, c.engine, bases, exps, reference);
+    }
+}
+
+template <std::size_t Limbs>
+void benchLimbs()
+{
+    using Value = BigUInt<Limbs>;
+    Value n;
+    for (std::size_t i = 0; i < Limbs; ++i)
+    {
+        n[i] = rng();
+    }
+    n[0] |= 1;
+    n[Limbs - 1] |= std::uint64_t(1) << 63;
+
+    std::vector<Value> bases;
+    std::vector<Value> exps;
+    for (std::size_t i = 0; i < POOL_SIZE; ++i)
+    {
+        Value a;
+        Value e;
+        for (std::size_t k = 0; k < Limbs; ++k)
+        {
+            a[k] = rng();
+            e[k] = rng();
+        }
+        a[Limbs - 1] >>= 1; // below n's top bit, so a < n
+        e[Limbs - 1] |= std::uint64_t(1) << 63;
+        bases.push_back(a);
+        exps.push_back(e);
+    }
+
+    std::vector<Value> reference;
+    BigMontgomeryContext<Limbs> ctx(n);
+    for (const EngineCase &c : ENGINES)
+    {
+        benchEngine(Value::BITS, std::string("cios-") + c.name, ctx, c.engine, bases, exps,
+                    reference);
+    }
+}
+
+} // namespace
+
+int main(int argc, char *argv[])
+{
+    BenchArgs args;
+    if (!parseBenchArgs(argc, argv, args))
+    {
+        return EXIT_FAILURE;
+    }
+
+    benchWords(32);
+    benchWords(63);
+    if (args.maxBits >= 512)
+    {
+        benchLimbs<8>();
+    }
+    if (args.maxBits >= 1024)
+    {
+        benchLimbs<16>();
+    }
+    if (args.maxBits >= 2048)
+    {
+        benchLimbs<32>();
+    }
+    if (args.maxBits >= 4096)
+    {
+        benchLimbs<64>();
+    }
+
+    report.print(std::cout, args.json);
+
+    if (mismatches > 0)
+    {
+        std::cerr << mismatches << " engine(s) disagreed with the reference" << std::endl;
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,248 @@
+#ifndef BATCH_EXP_H
+#define BATCH_EXP_H
+
+#include "exp_engines.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+/**
+ * @file batch_exp.hpp
+ * @brief Many independent exponentiations modulo one n.
+ *
+ * A batch shares a single context, so the per-modulus setup (n', R^2 mod n)
+ * is paid once. Within a thread, BATCH_LANES exponentiations advance in
+ * lockstep: each step issues one independent multiplication per lane, which
+ * keeps several multiply/reduce dependency chains in flight on an
+ * out-of-order core instead of waiting on one. Chunks of the batch run on
+ * separate threads.
+ */
+
+/** @brief Exponentiations interleaved per thread. */
+constexpr std::size_t BATCH_LANES = 4;
+
+/** @brief Smallest chunk worth handing to its own thread. */
+constexpr std::size_t BATCH_MIN_PER_THREAD = 64;
+
+/**
+ * @brief Split [0, count) into contiguous chunks and run fn(begin, end, chunk) on each.
+ *
+ * Uses up to maxThreads threads (0 = std::thread::hardware_concurrency()),
+ * but never gives a thread fewer than minPerThread items. A single chunk runs
+ * on the calling thread.
+ *
+ * @return std::size_t Number of chunks (at least 1)
+ */
+template <class Fn>
+std::size_t parallelChunks(std::size_t count, std::size_t minPerThread, std::size_t maxThreads,
+                           Fn fn)
+{
+    std::size_t threads = maxThreads ? maxThreads : std::thread::hardware_concurrency();
+    threads = std::min(std::max<std::size_t>(threads, 1),
+                       std::max<std::size_t>(count / std::max<std::size_t>(minPerThread, 1), 1));
+    if (threads == 1)
+    {
+        fn(std::size_t(0), count, std::size_t(0));
+        return 1;
+    }
+
+    std::vector<std::thread> workers;
+    workers.reserve(threads);
+    std::size_t per = count / threads;
+    std::size_t extra = count % threads;
+    std::size_t begin = 0;
+    for (std::size_t t = 0; t < threads; ++t)
+    {
+        std::size_t end = begin + per + (t < extra ? 1 : 0);
+        workers.emplace_back(fn, begin, end, t);
+        begin = end;
+    }
+    for (std::thread &worker : workers)
+    {
+        worker.join();
+    }
+    return threads;
+}
+
+/**
+ * @brief Fixed-window exponentiation of up to BATCH_LANES operands in lockstep.
+ *
+ * bases are in the context's internal form; results are written to out in
+ * the same form. The window comes from the longest exponent in the group
+ * unless windowBits is non-zero. Lanes whose exponent is shorter start
+ * squaring only once their first non-zero digit is reached.
+ */
+template <class Context, class Exponent>
+void expFixedWindowInterleaved(const Context &ctx, const typename Context::Value *bases,
+                               const Exponent *exps, typename Context::Value *out,
+                               std::size_t lanes, std::size_t windowBits, ExpCounters &counters)
+{
+    using Value = typename Context::Value;
+
+    std::size_t bits = 0;
+    for (std::size_t l = 0; l < lanes; ++l)
+    {
+        bits = std::max(bits, exponentBitLength(exps[l]));
+    }
+    std::size_t w = windowBits ? windowBits : chooseWindowBits(bits);
+    w = std::min(w, MAX_WINDOW_BITS);
+
+    // Lane-major tables: table[i][l] = bases[l]^i, so one step touches adjacent entries
+    std::array<std::array<Value, BATCH_LANES>, std::size_t(1) << MAX_WINDOW_BITS> table;
+    std::size_t size = std::size_t(1) << w;
+    for (std::size_t l = 0; l < lanes; ++l)
+    {
+        table[1][l] = bases[l];
+    }
+    for (std::size_t i = 2; i < size; ++i)
+    {
+        for (std::size_t l = 0; l < lanes; ++l)
+        {
+            table[i][l] = ctx.multiply(table[i - 1][l], bases[l]);
+        }
+        counters.multiplications += lanes;
+    }
+
+    std::array<Value, BATCH_LANES> acc;
+    std::array<bool, BATCH_LANES> started;
+    for (std::size_t l = 0; l < lanes; ++l)
+    {
+        acc[l] = ctx.one();
+        started[l] = false;
+    }
+
+    std::size_t digits = (bits + w - 1) / w;
+    for (std::size_t d = digits; d-- > 0;)
+    {
+        for (std::size_t k = 0; k < w; ++k)
+        {
+            for (std::size_t l = 0; l < lanes; ++l)
+            {
+                if (started[l])
+                {
+                    acc[l] = ctx.square(acc[l]);
+                    counters.squarings++;
+                }
+            }
+        }
+        for (std::size_t l = 0; l < lanes; ++l)
+        {
+            std::size_t digit = exponentDigit(exps[l], d * w, w);
+            if (digit == 0)
+            {
+                continue;
+            }
+            if (started[l])
+            {
+                acc[l] = ctx.multiply(acc[l], table[digit][l]);
+                counters.multiplications++;
+            }
+            else
+            {
+                acc[l] = table[digit][l];
+                started[l] = true;
+            }
+        }
+    }
+
+    for (std::size_t l = 0; l < lanes; ++l)
+    {
+        out[l] = acc[l];
+    }
+}
+
+/**
+ * @brief Engine exponentiateBatch() runs for engine: the constant-time engines
+ *        themselves, FixedWindow (interleaved) for all others.
+ */
+inline ExpEngine batchEngine(ExpEngine engine)
+{
+    bool constantTime = engine == ExpEngine::Ladder || engine == ExpEngine::ConstantTimeWindow;
+    return constantTime ? engine : ExpEngine::FixedWindow;
+}
+
+/**
+ * @brief Window exponentiateBatch() uses for the longest of exps[0..count).
+ *
+ * Interleaved lane groups pick their window from their own longest exponent,
+ * so this is the largest window any group of the batch uses.
+ */
+template <class Exponent>
+std::size_t batchWindowBits(ExpEngine engine, std::size_t windowBits, const Exponent *exps,
+                            std::size_t count)
+{
+    std::size_t w = 0;
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        w = std::max(w, resolveWindowBits(batchEngine(engine), windowBits, exps[i]));
+    }
+    return w;
+}
+
+/**
+ * @brief out[i] = bases[i]^exps[i] for i < count, all modulo the context's n.
+ *
+ * bases and out are ordinary residues; conversion to and from the context's
+ * internal form happens inside the workers. The constant-time engines run
+ * each operand on its own through exponentiate() so their guarantees hold;
+ * every other engine uses expFixedWindowInterleaved().
+ *
+ * @param threads Worker limit (0 = hardware concurrency)
+ * @param counters Receives the operation counts summed over the batch
+ */
+template <class Context, class Exponent>
+void exponentiateBatch(const Context &ctx, const typename Context::Value *bases,
+                       const Exponent *exps, typename Context::Value *out, std::size_t count,
+                       ExpEngine engine, std::size_t windowBits, std::size_t threads,
+                       ExpCounters &counters)
+{
+    using Value = typename Context::Value;
+
+    bool constantTime = batchEngine(engine) != ExpEngine::FixedWindow;
+    std::vector<ExpCounters> chunkCounters(
+        std::max<std::size_t>(threads ? threads : std::thread::hardware_concurrency(), 1));
+
+    std::size_t chunks = parallelChunks(
+        count, BATCH_MIN_PER_THREAD, chunkCounters.size(),
+        [&](std::size_t begin, std::size_t end, std::size_t chunk)
+        {
+            ExpCounters &local = chunkCounters[chunk];
+            for (std::size_t i = begin; i < end; i += BATCH_LANES)
+            {
+                std::size_t lanes = std::min(BATCH_LANES, end - i);
+                std::array<Value, BATCH_LANES> mont;
+                for (std::size_t l = 0; l < lanes; ++l)
+                {
+                    mont[l] = ctx.toMontgomery(bases[i + l]);
+                }
+
+                if (constantTime)
+                {
+                    for (std::size_t l = 0; l < lanes; ++l)
+                    {
+                        mont[l] = exponentiate(ctx, mont[l], exps[i + l], engine, windowBits,
+                                               local);
+                    }
+                }
+                else
+                {
+                    expFixedWindowInterleaved(ctx, mont.data(), exps + i, mont.data(), lanes,
+                                              windowBits, local);
+                }
+
+                for (std::size_t l = 0; l < lanes; ++l)
+                {
+                    out[i + l] = ctx.fromMontgomery(mont[l]);
+                }
+            }
+        });
+
+    for (std::size_t c = 0; c < chunks; ++c)
+    {
+        counters.squarings += chunkCounters[c].squarings;
+        counters.multiplications += chunkCounters[c].multiplications;
+    }
+}
+
+#endif // BATCH_EXP_H
@@ -0,0 +1,187 @@
+#ifndef BATCH_INVERSE_HPP
+#define BATCH_INVERSE_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <vector>
+#include "batch_exp.hpp"
+#include "gcd_engine.hpp"
+
+/**
+ * @brief Smallest chunk handed to its own thread (each chunk pays one extended GCD).
+ */
+const std::size_t INVERSE_BATCH_MIN_PER_THREAD = 256;
+
+/**
+ * @name Modular multiplication of residues in [0, m)
+ *
+ * Each overload forms the product in a type twice as wide as its operands, so
+ * it is exact for any modulus the operand type can hold.
+ * @{
+ */
+inline int mul_mod(int a, int b, int m)
+{
+    return static_cast<int>(static_cast<long long>(a) * b % m);
+}
+
+inline long mul_mod(long a, long b, long m)
+{
+    return static_cast<long>(static_cast<__int128>(a) * b % m);
+}
+
+inline long long mul_mod(long long a, long long b, long long m)
+{
+    return static_cast<long long>(static_cast<__int128>(a) * b % m);
+}
+
+inline __int128 mul_mod(__int128 a, __int128 b, __int128 m)
+{
+    BigUInt<2> wide_a, wide_b, wide_m;
+    wide_a[0] = static_cast<std::uint64_t>(a);
+    wide_a[1] = static_cast<std::uint64_t>(a >> 64);
+    wide_b[0] = static_cast<std::uint64_t>(b);
+    wide_b[1] = static_cast<std::uint64_t>(b >> 64);
+    wide_m[0] = static_cast<std::uint64_t>(m);
+    wide_m[1] = static_cast<std::uint64_t>(m >> 64);
+    BigUInt<4> product = multiplyWide(wide_a, wide_b) % wide_m.resize<4>();
+    return static_cast<__int128>((static_cast<unsigned __int128>(product[1]) << 64) | product[0]);
+}
+
+template <std::size_t Limbs>
+BigInt<Limbs> mul_mod(const BigInt<Limbs> &a, const BigInt<Limbs> &b, const BigInt<Limbs> &m)
+{
+    BigUInt<2 * Limbs> product = multiplyWide(a.magnitude(), b.magnitude());
+    BigUInt<2 * Limbs> modulus = m.magnitude().template resize<2 * Limbs>();
+    return BigInt<Limbs>((product % modulus).template resize<Limbs>());
+}
+/** @} */
+
+/**
+ * @brief Inverts xs[begin, end) modulo m into out with Montgomery's trick.
+ *
+ * Elements congruent to 0 are marked -1 up front and skipped. The prefix
+ * products of the others are inverted with a single extended GCD, and the
+ * inverse of each element is then peeled off walking backwards: 3(N-1)
+ * multiplications for N elements.
+ *
+ * If the full product is not invertible (only possible for a composite m),
+ * the first failing element is located by binary search over the prefix
+ * products, with one GCD per probe. It is marked -1, the elements before it
+ * are finished with the inverse of the preceding prefix, and the scan resumes
+ * after it. Each such element thus costs about log2(N) GCDs and a pass over
+ * the rest of the chunk; the trick pays off when failures are rare.
+ *
+ * @return The number of elements without an inverse.
+ */
+template <typename T>
+std::size_t mod_inverse_chunk(const T *xs, T *out, std::size_t begin, std::size_t end, const T &m,
+                              GcdEngine engine)
+{
+    std::size_t failures = 0;
+    for (std::size_t i = begin; i < end; ++i)
+    {
+        T residue = xs[i] % m;
+        if (residue < T(0))
+            residue = residue + m;
+        out[i] = residue;
+        if (residue == T(0) && m != T(1))
+        {
+            out[i] = T(-1);
+            failures++;
+        }
+    }
+    if (m == T(1))
+        return failures; // Every residue is 0, which is its own inverse modulo 1
+
+    // prefix[i - start] = product of the unmarked residues in [start, i]
+    std::vector<T> prefix;
+    prefix.reserve(end - begin);
+    std::size_t start = begin;
+    while (start < end)
+    {
+        prefix.clear();
+        T running(1);
+        for (std::size_t i = start; i < end; ++i)
+        {
+            if (out[i] != T(-1))
+                running = running == T(1) ? out[i] : mul_mod(running, out[i], m);
+            prefix.push_back(running);
+        }
+
+        std::size_t stop = end;
+        T inverse = mod_inverse(prefix.back(), m, engine);
+        if (inverse == T(-1))
+        {
+            std::size_t low = start;
+            std::size_t high = end - 1;
+            while (low < high)
+            {
+                std::size_t mid = low + (high - low) / 2;
+                if (gcd(prefix[mid - start], m, engine) != T(1))
+                    high = mid;
+                else
+                    low = mid + 1;
+            }
+            stop = low;
+            out[stop] = T(-1);
+            failures++;
+            inverse = stop > start ? mod_inverse(prefix[stop - 1 - start], m, engine) : T(1);
+        }
+
+        // inverse = (product of the unmarked residues in [start, i])^-1 at the top of each step
+        for (std::size_t i = stop; i-- > start;)
+        {
+            if (out[i] == T(-1))
+                continue;
+            T residue = out[i];
+            T before = i > start ? prefix[i - 1 - start] : T(1);
+            out[i] = before == T(1) ? inverse : mul_mod(inverse, before, m);
+            inverse = mul_mod(inverse, residue, m);
+        }
+        start = stop + 1;
+    }
+    return failures;
+}
+
+/**
+ * @brief Finds the Modular Inverses of count integers modulo the same y with Montgomery's trick.
+ *
+ * out[i] receives the inverse of xs[i] in [0, y), or -1 where none exists, exactly as
+ * mod_inverse() would return. Each chunk of the input costs one extended GCD
+ * (computed with engine) plus about three modular multiplications per element.
+ * Chunks of at least INVERSE_BATCH_MIN_PER_THREAD elements run on separate
+ * threads. xs and out may be the same array.
+ *
+ * @tparam T A signed integer type: int32_t, int64_t, __int128 or BigInt<Limbs>.
+ * @param[in] xs The integers to invert; negative values are allowed.
+ * @param[out] out Receives the inverses.
+ * @param[in] count The number of integers.
+ * @param[in] y The modulus, y > 0.
+ * @param[in] threads The maximum number of threads (0 = all cores).
+ * @param[in] engine The algorithm for the extended GCD of each chunk.
+ * @return The number of integers without an inverse.
+ */
+template <typename T>
+std::size_t mod_inverse_batch(const T *xs, T *out, std::size_t count, const T &y,
+                              std::size_t threads = 0, GcdEngine engine = GcdEngine::Euclidean)
+{
+    std::atomic<std::size_t> failures(0);
+    parallelChunks(count, INVERSE_BATCH_MIN_PER_THREAD, threads,
+                   [&](std::size_t begin, std::size_t end, std::size_t)
+                   { failures += mod_inverse_chunk(xs, out, begin, end, y, engine); });
+    return failures;
+}
+
+/**
+ * @brief Convenience overload of mod_inverse_batch() returning a new vector.
+ */
+template <typename T>
+std::vector<T> mod_inverse_batch(const std::vector<T> &xs, const T &y, std::size_t threads = 0,
+                                 GcdEngine engine = GcdEngine::Euclidean)
+{
+    std::vector<T> out(xs.size());
+    mod_inverse_batch(xs.data(), out.data(), xs.size(), y, threads, engine);
+    return out;
+}
+
+#endif // BATCH_INVERSE_HPP
@@ -0,0 +1,145 @@
+#ifndef BIG_INT_H
+#define BIG_INT_H
+
+#include "big_uint.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+/**
+ * @class BigInt
+ * @brief Signed fixed-capacity integer: a sign and a BigUInt<Limbs> magnitude.
+ *
+ * Supports the operations generic integer code needs (+, -, *, /, %,
+ * comparisons, construction from long long) with the semantics of the
+ * built-in types: division truncates toward zero and the remainder takes
+ * the sign of the dividend. Magnitudes wrap modulo 2^(64·Limbs) like
+ * BigUInt, so callers must size Limbs for their largest intermediate.
+ * Zero is always non-negative.
+ */
+template <std::size_t Limbs>
+class BigInt
+{
+public:
+    using Magnitude = BigUInt<Limbs>;
+
+    BigInt() : magnitude_(), negative_(false) {}
+
+    BigInt(long long value)
+        : magnitude_(value < 0 ? 0 - static_cast<std::uint64_t>(value)
+                               : static_cast<std::uint64_t>(value)),
+          negative_(value < 0)
+    {
+    }
+
+    explicit BigInt(const Magnitude &magnitude, bool negative = false)
+        : magnitude_(magnitude), negative_(negative && !magnitude.isZero())
+    {
+    }
+
+    /**
+     * @brief Parse an optional '-' followed by decimal or 0x-prefixed hex digits.
+     *
+     * @throws std::invalid_argument / std::overflow_error as BigUInt::fromString()
+     */
+    static BigInt fromString(const std::string &text)
+    {
+        bool negative = !text.empty() && text[0] == '-';
+        return BigInt(Magnitude::fromString(negative ? text.substr(1) : text), negative);
+    }
+
+    /**
+     * @brief Decimal representation with a leading '-' for negative values.
+     */
+    std::string toString() const { return (negative_ ? "-" : "") + magnitude_.toString(); }
+
+    const Magnitude &magnitude() const { return magnitude_; }
+
+    bool isNegative() const { return negative_; }
+
+    bool isZero() const { return magnitude_.isZero(); }
+
+    BigInt operator-() const { return BigInt(magnitude_, !negative_); }
+
+    friend BigInt operator+(const BigInt &a, const BigInt &b)
+    {
+        if (a.negative_ == b.negative_)
+        {
+            return BigInt(a.magnitude_ + b.magnitude_, a.negative_);
+        }
+        // Opposite signs: the larger magnitude keeps its sign
+        if (a.magnitude_ >= b.magnitude_)
+        {
+            return BigInt(a.magnitude_ - b.magnitude_, a.negative_);
+        }
+        return BigInt(b.magnitude_ - a.magnitude_, b.negative_);
+    }
+
+    friend BigInt operator-(const BigInt &a, const BigInt &b) { return a + (-b); }
+
+    friend BigInt operator*(const BigInt &a, const BigInt &b)
+    {
+        return BigInt(a.magnitude_ * b.magnitude_, a.negative_ != b.negative_);
+    }
+
+    /**
+     * @brief Truncating division: quotient toward zero, remainder with a's sign.
+     *
+     * @throws std::invalid_argument if b is zero
+     */
+    friend void divmod(const BigInt &a, const BigInt &b, BigInt &quotient, BigInt &remainder)
+    {
+        Magnitude q;
+        Magnitude r;
+        divmod(a.magnitude_, b.magnitude_, q, r);
+        quotient = BigInt(q, a.negative_ != b.negative_);
+        remainder = BigInt(r, a.negative_);
+    }
+
+    friend BigInt operator/(const BigInt &a, const BigInt &b)
+    {
+        BigInt quotient;
+        BigInt remainder;
+        divmod(a, b, quotient, remainder);
+        return quotient;
+    }
+
+    friend BigInt operator%(const BigInt &a, const BigInt &b)
+    {
+        BigInt quotient;
+        BigInt remainder;
+        divmod(a, b, quotient, remainder);
+        return remainder;
+    }
+
+    /**
+     * @brief Three-way comparison: negative, zero or positive.
+     */
+    int compare(const BigInt &other) const
+    {
+        if (negative_ != other.negative_)
+        {
+            return negative_ ? -1 : 1;
+        }
+        int magnitudeOrder = magnitude_.compare(other.magnitude_);
+        return negative_ ? -magnitudeOrder : magnitudeOrder;
+    }
+
+    friend bool operator==(const BigInt &a, const BigInt &b) { return a.compare(b) == 0; }
+    friend bool operator!=(const BigInt &a, const BigInt &b) { return a.compare(b) != 0; }
+    friend bool operator<(const BigInt &a, const BigInt &b) { return a.compare(b) < 0; }
+    friend bool operator>(const BigInt &a, const BigInt &b) { return a.compare(b) > 0; }
+    friend bool operator<=(const BigInt &a, const BigInt &b) { return a.compare(b) <= 0; }
+    friend bool operator>=(const BigInt &a, const BigInt &b) { return a.compare(b) >= 0; }
+
+private:
+    Magnitude magnitude_; ///< Absolute value
+    bool negative_;       ///< Sign; false for zero
+};
+
+using Int512 = BigInt<8>;   ///< Signed 512-bit magnitude
+using Int1024 = BigInt<16>; ///< Signed 1024-bit magnitude
+using Int2048 = BigInt<32>; ///< Signed 2048-bit magnitude
+using Int4096 = BigInt<64>; ///< Signed 4096-bit magnitude
+
+#endif // BIG_INT_H
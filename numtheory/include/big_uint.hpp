@@ -0,0 +1,569 @@
+#ifndef BIG_UINT_H
+#define BIG_UINT_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+
+/**
+ * @class BigUInt
+ * @brief Fixed-capacity unsigned integer of Limbs 64-bit words.
+ *
+ * Limbs are stored little-endian (limb 0 is least significant) in a
+ * std::array, so values live on the stack and copy with no allocation.
+ * Arithmetic wraps modulo 2^(64·Limbs) unless stated otherwise; the
+ * Montgomery code in montgomery_big.hpp keeps values below the modulus.
+ * Division (divmod(), '/', '%') is exact and is meant for setup work such
+ * as inverses and key generation, not for inner loops.
+ */
+template <std::size_t Limbs>
+class BigUInt
+{
+    static_assert(Limbs > 0, "BigUInt needs at least one limb");
+
+public:
+    static constexpr std::size_t LIMBS = Limbs;    ///< Number of 64-bit limbs
+    static constexpr std::size_t BITS = Limbs * 64; ///< Capacity in bits
+
+    /**
+     * @brief Zero.
+     */
+    BigUInt() : limbs_{} {}
+
+    /**
+     * @brief Construct from a single 64-bit value.
+     */
+    BigUInt(std::uint64_t value) : limbs_{} { limbs_[0] = value; }
+
+    /**
+     * @brief Parse a decimal string, or a hexadecimal one with a "0x" prefix.
+     *
+     * @throws std::invalid_argument on an empty string or a bad digit
+     * @throws std::overflow_error if the value does not fit in Limbs limbs
+     */
+    static BigUInt fromString(const std::string &text)
+    {
+        bool hex = text.size() > 2 && text[0] == '0' && (text[1] == 'x' || text[1] == 'X');
+        std::size_t start = hex ? 2 : 0;
+        if (text.size() == start)
+        {
+            throw std::invalid_argument("BigUInt::fromString: empty number");
+        }
+
+        BigUInt value;
+        for (std::size_t i = start; i < text.size(); ++i)
+        {
+            int digit = digitValue(text[i]);
+            if (digit < 0 || digit >= (hex ? 16 : 10))
+            {
+                throw std::invalid_argument("BigUInt::fromString: invalid digit in '" + text + "'");
+            }
+            if (value.mulAddSmall(hex ? 16 : 10, static_cast<std::uint64_t>(digit)) != 0)
+            {
+                throw std::overflow_error("BigUInt::fromString: value does not fit");
+            }
+        }
+        return value;
+    }
+
+    /**
+     * @brief Decimal representation.
+     */
+    std::string toString() const
+    {
+        if (isZero())
+        {
+            return "0";
+        }
+
+        // Peel off 19 decimal digits at a time
+        const std::uint64_t chunk = 10000000000000000000ULL;
+        BigUInt value = *this;
+        std::string digits;
+        while (!value.isZero())
+        {
+            std::uint64_t part = value.divSmall(chunk);
+            for (int i = 0; i < 19 && (part != 0 || !value.isZero()); ++i)
+            {
+                digits.push_back(static_cast<char>('0' + part % 10));
+                part /= 10;
+            }
+        }
+        return std::string(digits.rbegin(), digits.rend());
+    }
+
+    /**
+     * @brief Hexadecimal representation with a "0x" prefix.
+     */
+    std::string toHex() const
+    {
+        static const char DIGITS[] = "0123456789abcdef";
+        std::string text = "0x";
+        bool leading = true;
+        for (std::size_t i = Limbs * 16; i-- > 0;)
+        {
+            unsigned nibble = (limbs_[i / 16] >> (4 * (i % 16))) & 0xF;
+            if (nibble != 0 || !leading || i == 0)
+            {
+                text.push_back(DIGITS[nibble]);
+                leading = false;
+            }
+        }
+        return text;
+    }
+
+    /**
+     * @brief Access limb i (0 = least significant).
+     */
+    std::uint64_t &operator[](std::size_t i) { return limbs_[i]; }
+    const std::uint64_t &operator[](std::size_t i) const { return limbs_[i]; }
+
+    /**
+     * @brief Raw little-endian limb storage.
+     */
+    std::uint64_t *data() { return limbs_.data(); }
+    const std::uint64_t *data() const { return limbs_.data(); }
+
+    bool isZero() const
+    {
+        std::uint64_t any = 0;
+        for (std::uint64_t limb : limbs_)
+        {
+            any |= limb;
+        }
+        return any == 0;
+    }
+
+    bool isOdd() const { return limbs_[0] & 1; }
+
+    /**
+     * @brief Number of significant bits (0 for zero).
+     */
+    std::size_t bitLength() const
+    {
+        for (std::size_t i = Limbs; i-- > 0;)
+        {
+            if (limbs_[i] != 0)
+            {
+                return i * 64 + 64 - static_cast<std::size_t>(__builtin_clzll(limbs_[i]));
+            }
+        }
+        return 0;
+    }
+
+    /**
+     * @brief Number of trailing zero bits (BITS for zero).
+     */
+    std::size_t trailingZeros() const
+    {
+        for (std::size_t i = 0; i < Limbs; ++i)
+        {
+            if (limbs_[i] != 0)
+            {
+                return i * 64 + static_cast<std::size_t>(__builtin_ctzll(limbs_[i]));
+            }
+        }
+        return BITS;
+    }
+
+    /**
+     * @brief Bit i (0 = least significant); bits beyond the capacity read as 0.
+     */
+    bool testBit(std::size_t i) const
+    {
+        return i < BITS && ((limbs_[i / 64] >> (i % 64)) & 1);
+    }
+
+    /**
+     * @brief Three-way comparison: negative, zero or positive.
+     */
+    int compare(const BigUInt &other) const
+    {
+        for (std::size_t i = Limbs; i-- > 0;)
+        {
+            if (limbs_[i] != other.limbs_[i])
+            {
+                return limbs_[i] < other.limbs_[i] ? -1 : 1;
+            }
+        }
+        return 0;
+    }
+
+    friend bool operator==(const BigUInt &a, const BigUInt &b) { return a.compare(b) == 0; }
+    friend bool operator!=(const BigUInt &a, const BigUInt &b) { return a.compare(b) != 0; }
+    friend bool operator<(const BigUInt &a, const BigUInt &b) { return a.compare(b) < 0; }
+    friend bool operator<=(const BigUInt &a, const BigUInt &b) { return a.compare(b) <= 0; }
+    friend bool operator>(const BigUInt &a, const BigUInt &b) { return a.compare(b) > 0; }
+    friend bool operator>=(const BigUInt &a, const BigUInt &b) { return a.compare(b) >= 0; }
+
+    /**
+     * @brief this += other; returns the carry out of the top limb.
+     */
+    std::uint64_t addInPlace(const BigUInt &other)
+    {
+        unsigned __int128 carry = 0;
+        for (std::size_t i = 0; i < Limbs; ++i)
+        {
+            carry += static_cast<unsigned __int128>(limbs_[i]) + other.limbs_[i];
+            limbs_[i] = static_cast<std::uint64_t>(carry);
+            carry >>= 64;
+        }
+        return static_cast<std::uint64_t>(carry);
+    }
+
+    /**
+     * @brief this -= other; returns the borrow out of the top limb.
+     */
+    std::uint64_t subInPlace(const BigUInt &other)
+    {
+        std::uint64_t borrow = 0;
+        for (std::size_t i = 0; i < Limbs; ++i)
+        {
+            std::uint64_t a = limbs_[i];
+            std::uint64_t b = other.limbs_[i];
+            std::uint64_t diff = a - b - borrow;
+            borrow = (a < b) | (a - b < borrow); // no short-circuit branch
+            limbs_[i] = diff;
+        }
+        return borrow;
+    }
+
+    /**
+     * @brief this = this·factor + addend; returns the limb carried out of the top.
+     */
+    std::uint64_t mulAddSmall(std::uint64_t factor, std::uint64_t addend)
+    {
+        unsigned __int128 carry = addend;
+        for (std::size_t i = 0; i < Limbs; ++i)
+        {
+            carry += static_cast<unsigned __int128>(limbs_[i]) * factor;
+            limbs_[i] = static_cast<std::uint64_t>(carry);
+            carry >>= 64;
+        }
+        return static_cast<std::uint64_t>(carry);
+    }
+
+    /**
+     * @brief this /= divisor; returns the remainder. divisor must be non-zero.
+     */
+    std::uint64_t divSmall(std::uint64_t divisor)
+    {
+        unsigned __int128 remainder = 0;
+        for (std::size_t i = Limbs; i-- > 0;)
+        {
+            unsigned __int128 current = (remainder << 64) | limbs_[i];
+            limbs_[i] = static_cast<std::uint64_t>(current / divisor);
+            remainder = current % divisor;
+        }
+        return static_cast<std::uint64_t>(remainder);
+    }
+
+    /**
+     * @brief Remainder of this modulo a non-zero 64-bit divisor.
+     */
+    std::uint64_t modSmall(std::uint64_t divisor) const
+    {
+        unsigned __int128 remainder = 0;
+        for (std::size_t i = Limbs; i-- > 0;)
+        {
+            remainder = ((remainder << 64) | limbs_[i]) % divisor;
+        }
+        return static_cast<std::uint64_t>(remainder);
+    }
+
+    /**
+     * @brief Shift left by one bit; returns the bit shifted out of the top.
+     */
+    std::uint64_t shiftLeft1()
+    {
+        std::uint64_t carry = 0;
+        for (std::size_t i = 0; i < Limbs; ++i)
+        {
+            std::uint64_t next = limbs_[i] >> 63;
+            limbs_[i] = (limbs_[i] << 1) | carry;
+            carry = next;
+        }
+        return carry;
+    }
+
+    /**
+     * @brief Shift right by one bit.
+     */
+    void shiftRight1()
+    {
+        for (std::size_t i = 0; i < Limbs; ++i)
+        {
+            std::uint64_t high = (i + 1 < Limbs) ? limbs_[i + 1] << 63 : 0;
+            limbs_[i] = (limbs_[i] >> 1) | high;
+        }
+    }
+
+    /**
+     * @brief Shift left by bits; bits shifted out of the top are lost.
+     */
+    void shiftLeft(std::size_t bits)
+    {
+        std::size_t limbShift = bits / 64;
+        std::size_t bitShift = bits % 64;
+        for (std::size_t i = Limbs; i-- > 0;)
+        {
+            std::uint64_t value = 0;
+            if (i >= limbShift)
+            {
+                value = limbs_[i - limbShift] << bitShift;
+                if (bitShift != 0 && i > limbShift)
+                {
+                    value |= limbs_[i - limbShift - 1] >> (64 - bitShift);
+                }
+            }
+            limbs_[i] = value;
+        }
+    }
+
+    /**
+     * @brief Shift right by bits.
+     */
+    void shiftRight(std::size_t bits)
+    {
+        std::size_t limbShift = bits / 64;
+        std::size_t bitShift = bits % 64;
+        for (std::size_t i = 0; i < Limbs; ++i)
+        {
+            std::uint64_t value = 0;
+            if (i + limbShift < Limbs)
+            {
+                value = limbs_[i + limbShift] >> bitShift;
+                if (bitShift != 0 && i + limbShift + 1 < Limbs)
+                {
+                    value |= limbs_[i + limbShift + 1] << (64 - bitShift);
+                }
+            }
+            limbs_[i] = value;
+        }
+    }
+
+    friend BigUInt operator+(BigUInt a, const BigUInt &b)
+    {
+        a.addInPlace(b);
+        return a;
+    }
+
+    friend BigUInt operator-(BigUInt a, const BigUInt &b)
+    {
+        a.subInPlace(b);
+        return a;
+    }
+
+    /**
+     * @brief Zero-extend or truncate to another limb count.
+     */
+    template <std::size_t Other>
+    BigUInt<Other> resize() const
+    {
+        BigUInt<Other> out;
+        for (std::size_t i = 0; i < Limbs && i < Other; ++i)
+        {
+            out[i] = limbs_[i];
+        }
+        return out;
+    }
+
+    /**
+     * @brief Full product of two Limbs-limb values (schoolbook).
+     */
+    friend BigUInt<2 * Limbs> multiplyWide(const BigUInt &a, const BigUInt &b)
+    {
+        BigUInt<2 * Limbs> product;
+        for (std::size_t i = 0; i < Limbs; ++i)
+        {
+            unsigned __int128 carry = 0;
+            for (std::size_t j = 0; j < Limbs; ++j)
+            {
+                carry += static_cast<unsigned __int128>(a.limbs_[j]) * b.limbs_[i] + product[i + j];
+                product[i + j] = static_cast<std::uint64_t>(carry);
+                carry >>= 64;
+            }
+            product[i + Limbs] = static_cast<std::uint64_t>(carry);
+        }
+        return product;
+    }
+
+    /**
+     * @brief Low Limbs limbs of the product (wraps like the other operators).
+     */
+    friend BigUInt operator*(const BigUInt &a, const BigUInt &b)
+    {
+        BigUInt product;
+        for (std::size_t i = 0; i < Limbs; ++i)
+        {
+            unsigned __int128 carry = 0;
+            for (std::size_t j = 0; i + j < Limbs; ++j)
+            {
+                carry += static_cast<unsigned __int128>(a.limbs_[j]) * b.limbs_[i] +
+                         product.limbs_[i + j];
+                product.limbs_[i + j] = static_cast<std::uint64_t>(carry);
+                carry >>= 64;
+            }
+        }
+        return product;
+    }
+
+    /**
+     * @brief quotient = a / b and remainder = a % b (Knuth's Algorithm D).
+     *
+     * Divisors of one limb use divSmall(); otherwise both operands are
+     * normalised so the divisor's top bit is set, and each quotient limb is
+     * estimated from the top two dividend limbs and corrected at most twice.
+     *
+     * @throws std::invalid_argument if b is zero
+     */
+    friend void divmod(const BigUInt &a, const BigUInt &b, BigUInt &quotient, BigUInt &remainder)
+    {
+        std::size_t n = b.significantLimbs();
+        std::size_t m = a.significantLimbs();
+        if (n == 0)
+        {
+            throw std::invalid_argument("BigUInt: division by zero");
+        }
+        if (a < b)
+        {
+            remainder = a;
+            quotient = BigUInt();
+            return;
+        }
+        if (n == 1)
+        {
+            quotient = a;
+            remainder = BigUInt(quotient.divSmall(b.limbs_[0]));
+            return;
+        }
+
+        // Normalise: shift so the divisor's top limb has its high bit set
+        unsigned shift = static_cast<unsigned>(__builtin_clzll(b.limbs_[n - 1]));
+        std::array<std::uint64_t, Limbs> v{};
+        std::array<std::uint64_t, Limbs + 1> u{};
+        for (std::size_t i = n; i-- > 0;)
+        {
+            v[i] = (b.limbs_[i] << shift) | (shift && i > 0 ? b.limbs_[i - 1] >> (64 - shift) : 0);
+        }
+        u[m] = shift ? a.limbs_[m - 1] >> (64 - shift) : 0;
+        for (std::size_t i = m; i-- > 0;)
+        {
+            u[i] = (a.limbs_[i] << shift) | (shift && i > 0 ? a.limbs_[i - 1] >> (64 - shift) : 0);
+        }
+
+        const unsigned __int128 base = static_cast<unsigned __int128>(1) << 64;
+        quotient = BigUInt();
+        for (std::size_t j = m - n + 1; j-- > 0;)
+        {
+            unsigned __int128 numerator = (static_cast<unsigned __int128>(u[j + n]) << 64) |
+                                          u[j + n - 1];
+            unsigned __int128 qhat = numerator / v[n - 1];
+            unsigned __int128 rhat = numerator % v[n - 1];
+            while (qhat >= base || qhat * v[n - 2] > ((rhat << 64) | u[j + n - 2]))
+            {
+                qhat--;
+                rhat += v[n - 1];
+                if (rhat >= base)
+                {
+                    break;
+                }
+            }
+
+            // u[j..j+n] -= qhat·v
+            std::uint64_t borrow = 0;
+            for (std::size_t i = 0; i < n; ++i)
+            {
+                unsigned __int128 product = qhat * v[i];
+                unsigned __int128 subtrahend = static_cast<unsigned __int128>(borrow) +
+                                               static_cast<std::uint64_t>(product);
+                std::uint64_t low = static_cast<std::uint64_t>(subtrahend);
+                std::uint64_t before = u[i + j];
+                u[i + j] = before - low;
+                borrow = static_cast<std::uint64_t>(product >> 64) +
+                         static_cast<std::uint64_t>(subtrahend >> 64) + (before < low ? 1 : 0);
+            }
+            std::uint64_t top = u[j + n];
+            u[j + n] = top - borrow;
+
+            std::uint64_t q = static_cast<std::uint64_t>(qhat);
+            if (top < borrow)
+            {
+                // qhat was one too large: add v back
+                q--;
+                unsigned __int128 carry = 0;
+                for (std::size_t i = 0; i < n; ++i)
+                {
+                    carry += static_cast<unsigned __int128>(u[i + j]) + v[i];
+                    u[i + j] = static_cast<std::uint64_t>(carry);
+                    carry >>= 64;
+                }
+                u[j + n] += static_cast<std::uint64_t>(carry);
+            }
+            quotient.limbs_[j] = q;
+        }
+
+        // Denormalise the remainder
+        remainder = BigUInt();
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            remainder.limbs_[i] = (u[i] >> shift) | (shift ? u[i + 1] << (64 - shift) : 0);
+        }
+    }
+
+    friend BigUInt operator/(const BigUInt &a, const BigUInt &b)
+    {
+        BigUInt quotient;
+        BigUInt remainder;
+        divmod(a, b, quotient, remainder);
+        return quotient;
+    }
+
+    friend BigUInt operator%(const BigUInt &a, const BigUInt &b)
+    {
+        BigUInt quotient;
+        BigUInt remainder;
+        divmod(a, b, quotient, remainder);
+        return remainder;
+    }
+
+private:
+    // Number of limbs up to and including the most significant non-zero one
+    std::size_t significantLimbs() const
+    {
+        std::size_t n = Limbs;
+        while (n > 0 && limbs_[n - 1] == 0)
+        {
+            --n;
+        }
+        return n;
+    }
+
+    static int digitValue(char c)
+    {
+        if (c >= '0' && c <= '9')
+        {
+            return c - '0';
+        }
+        if (c >= 'a' && c <= 'f')
+        {
+            return c - 'a' + 10;
+        }
+        if (c >= 'A' && c <= 'F')
+        {
+            return c - 'A' + 10;
+        }
+        return -1;
+    }
+
+    std::array<std::uint64_t, Limbs> limbs_; ///< Little-endian limbs
+};
+
+using UInt512 = BigUInt<8>;   ///< 512-bit operands
+using UInt1024 = BigUInt<16>; ///< 1024-bit operands
+using UInt2048 = BigUInt<32>; ///< 2048-bit operands
+using UInt4096 = BigUInt<64>; ///< 4096-bit operands
+
+#endif // BIG_UINT_H
@@ -0,0 +1,255 @@
+#ifndef BINARY_GCD_HPP
+#define BINARY_GCD_HPP
+
+#include <cstddef>
+#include <utility>
+#include "big_int.hpp"
+
+/**
+ * @brief Maps a signed integer type to the unsigned type holding its magnitude.
+ *
+ * The binary algorithms below work on magnitudes only; this keeps their shifts
+ * and subtractions well defined (including for the minimum value of T).
+ */
+template <typename T>
+struct unsigned_magnitude;
+
+template <>
+struct unsigned_magnitude<int>
+{
+    using type = unsigned int;
+};
+
+template <>
+struct unsigned_magnitude<long>
+{
+    using type = unsigned long;
+};
+
+template <>
+struct unsigned_magnitude<long long>
+{
+    using type = unsigned long long;
+};
+
+template <>
+struct unsigned_magnitude<__int128>
+{
+    using type = unsigned __int128;
+};
+
+template <std::size_t Limbs>
+struct unsigned_magnitude<BigInt<Limbs>>
+{
+    using type = BigUInt<Limbs>;
+};
+
+/**
+ * @name Unsigned primitives used by the binary algorithms
+ *
+ * Overloaded for the built-in unsigned types and BigUInt, so that binary_gcd()
+ * and binary_mod_inverse() are written once for every operand width.
+ * @{
+ */
+inline std::size_t trailing_zeros(unsigned int value) { return __builtin_ctz(value); }
+inline std::size_t trailing_zeros(unsigned long value) { return __builtin_ctzl(value); }
+inline std::size_t trailing_zeros(unsigned long long value) { return __builtin_ctzll(value); }
+
+inline std::size_t trailing_zeros(unsigned __int128 value)
+{
+    unsigned long long low = static_cast<unsigned long long>(value);
+    return low != 0 ? __builtin_ctzll(low)
+                    : 64 + __builtin_ctzll(static_cast<unsigned long long>(value >> 64));
+}
+
+template <std::size_t Limbs>
+std::size_t trailing_zeros(const BigUInt<Limbs> &value)
+{
+    return value.trailingZeros();
+}
+
+template <typename U>
+void shift_right(U &value, std::size_t bits) { value >>= bits; }
+
+template <std::size_t Limbs>
+void shift_right(BigUInt<Limbs> &value, std::size_t bits) { value.shiftRight(bits); }
+
+template <typename U>
+void shift_left(U &value, std::size_t bits) { value <<= bits; }
+
+template <std::size_t Limbs>
+void shift_left(BigUInt<Limbs> &value, std::size_t bits) { value.shiftLeft(bits); }
+
+template <typename U>
+bool is_zero(const U &value) { return value == U(0); }
+
+template <std::size_t Limbs>
+bool is_zero(const BigUInt<Limbs> &value) { return value.isZero(); }
+
+template <typename U>
+bool is_odd(const U &value) { return (value & 1) != 0; }
+
+template <std::size_t Limbs>
+bool is_odd(const BigUInt<Limbs> &value) { return value.isOdd(); }
+/** @} */
+
+/**
+ * @brief |value| as the matching unsigned type.
+ */
+template <typename T>
+typename unsigned_magnitude<T>::type to_magnitude(const T &value)
+{
+    using U = typename unsigned_magnitude<T>::type;
+    // Negate in the unsigned type so that the minimum value of T is handled too
+    return value < T(0) ? U(0) - static_cast<U>(value) : static_cast<U>(value);
+}
+
+template <std::size_t Limbs>
+BigUInt<Limbs> to_magnitude(const BigInt<Limbs> &value)
+{
+    return value.magnitude();
+}
+
+/**
+ * @brief Converts a non-negative magnitude back to the signed type.
+ */
+template <typename T>
+T from_magnitude(const typename unsigned_magnitude<T>::type &value)
+{
+    return T(value);
+}
+
+/**
+ * @brief Computes the GCD with Stein's binary algorithm.
+ *
+ * Replaces the divisions of the Euclidean Algorithm with trailing-zero counts,
+ * shifts and subtractions: the common power of two is factored out once, then
+ * the larger odd operand is repeatedly replaced by the difference of the two,
+ * with its trailing zeros shifted off in a single step.
+ *
+ * @tparam T A signed integer type: int32_t, int64_t, __int128 or BigInt<Limbs>.
+ * @param[in] a The first integer.
+ * @param[in] b The second integer.
+ * @return The GCD of a and b (non-negative).
+ */
+template <typename T>
+T binary_gcd(T a, T b)
+{
+    using U = typename unsigned_magnitude<T>::type;
+    U u = to_magnitude(a);
+    U v = to_magnitude(b);
+    if (is_zero(u))
+        return from_magnitude<T>(v);
+    if (is_zero(v))
+        return from_magnitude<T>(u);
+
+    std::size_t u_zeros = trailing_zeros(u);
+    std::size_t v_zeros = trailing_zeros(v);
+    std::size_t shift = u_zeros < v_zeros ? u_zeros : v_zeros;
+    shift_right(u, u_zeros);
+
+    // u stays odd; v is made odd at the top of each step
+    do
+    {
+        shift_right(v, trailing_zeros(v));
+        if (u > v)
+            std::swap(u, v);
+        v = v - u;
+    } while (!is_zero(v));
+
+    shift_left(u, shift);
+    return from_magnitude<T>(u);
+}
+
+/**
+ * @brief Computes (value / 2) mod m for value in [0, m) and odd m, without overflow.
+ */
+template <typename U>
+U halve_mod(U value, const U &m)
+{
+    if (!is_odd(value))
+    {
+        shift_right(value, 1);
+        return value;
+    }
+    // (value + m) / 2 with both odd, split so the sum cannot overflow
+    U half_m = m;
+    shift_right(half_m, 1);
+    shift_right(value, 1);
+    return value + half_m + U(1);
+}
+
+/**
+ * @brief Computes (a - b) mod m for a, b in [0, m).
+ */
+template <typename U>
+U sub_mod(const U &a, const U &b, const U &m)
+{
+    return a >= b ? a - b : a + (m - b);
+}
+
+/**
+ * @brief Finds the Modular Inverse of x modulo an odd y with the binary Extended Euclidean Algorithm.
+ *
+ * Runs Stein's algorithm on (x mod y, y) and carries, for each operand, the
+ * coefficient c with c·x ≡ operand (mod y). Halving an operand halves its
+ * coefficient modulo y, which is why y must be odd. All coefficients stay in
+ * [0, y), so no intermediate exceeds the modulus.
+ *
+ * @tparam T A signed integer type (see binary_gcd()).
+ * @param[in] x The integer whose modular inverse is to be found; negative values are allowed.
+ * @param[in] y The modulus; must be odd and positive.
+ * @return The modular inverse of x modulo y in [0, y) if it exists; otherwise, -1.
+ */
+template <typename T>
+T binary_mod_inverse(T x, T y)
+{
+    using U = typename unsigned_magnitude<T>::type;
+    T reduced = x % y;
+    if (reduced < T(0))
+        reduced = reduced + y;
+
+    const U m = to_magnitude(y);
+    if (m == U(1))
+        return T(0);
+    U u = to_magnitude(reduced);
+    if (is_zero(u))
+        return T(-1);
+
+    // Invariants: x_u·x ≡ u and x_v·x ≡ v (mod m); u and v are odd after each shift
+    U v = m;
+    U x_u = U(1);
+    U x_v = U(0);
+    std::size_t zeros = trailing_zeros(u);
+    shift_right(u, zeros);
+    for (; zeros > 0; --zeros)
+        x_u = halve_mod(x_u, m);
+
+    while (u != v)
+    {
+        if (u > v)
+        {
+            u = u - v;
+            x_u = sub_mod(x_u, x_v, m);
+            zeros = trailing_zeros(u);
+            shift_right(u, zeros);
+            for (; zeros > 0; --zeros)
+                x_u = halve_mod(x_u, m);
+        }
+        else
+        {
+            v = v - u;
+            x_v = sub_mod(x_v, x_u, m);
+            zeros = trailing_zeros(v);
+            shift_right(v, zeros);
+            for (; zeros > 0; --zeros)
+                x_v = halve_mod(x_v, m);
+        }
+    }
+
+    if (u != U(1))
+        return T(-1); // Inverse doesn't exist
+    return from_magnitude<T>(x_u);
+}
+
+#endif // BINARY_GCD_HPP
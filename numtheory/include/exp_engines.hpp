@@ -0,0 +1,534 @@
+#ifndef EXP_ENGINES_H
+#define EXP_ENGINES_H
+
+#include "big_uint.hpp"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+/**
+ * @file exp_engines.hpp
+ * @brief Exponentiation algorithms shared by the 64-bit and multi-limb engines.
+ *
+ * Every engine is a template over an arithmetic context (MontgomeryContext,
+ * BigMontgomeryContext, ...) exposing Value, one(), multiply() and square(),
+ * and over an exponent type with exponentBitLength()/exponentBit() overloads.
+ * The base is passed and the result returned in the context's representation
+ * (Montgomery form for the Montgomery contexts).
+ *
+ * The Ladder and ConstantTimeWindow engines have no exponent-dependent
+ * branches or memory accesses and always run for the full exponent width;
+ * with the Montgomery contexts, whose reductions are branch-free, the whole
+ * exponentiation runs in time independent of the exponent.
+ */
+
+/**
+ * @brief The exponentiation algorithm used by MontgomeryExp and BigMontgomeryExp.
+ */
+enum class ExpEngine
+{
+    Binary,        ///< Right-to-left square-and-multiply, one bit at a time
+    FixedWindow,   ///< Left-to-right k-ary: w squarings then one multiply per w-bit digit
+    SlidingWindow, ///< Left-to-right sliding window over precomputed odd powers (default)
+    Ladder,        ///< Constant-time Montgomery ladder over the full exponent width
+    ConstantTimeWindow ///< Constant-time fixed window with a full table scan per digit
+};
+
+/**
+ * @brief Largest supported window size; tables hold at most 2^MAX_WINDOW_BITS powers.
+ */
+constexpr std::size_t MAX_WINDOW_BITS = 6;
+
+#ifdef MONTGOMERY_NO_STATS
+/**
+ * @brief Stand-in counter for builds with MONTGOMERY_NO_STATS: updates compile
+ *        to nothing and it always reads as zero.
+ */
+struct DiscardedCount
+{
+    DiscardedCount &operator++() { return *this; }
+    DiscardedCount operator++(int) { return *this; }
+
+    template <class T>
+    DiscardedCount &operator+=(const T &)
+    {
+        return *this;
+    }
+
+    operator long long() const { return 0; }
+};
+
+using ExpCount = DiscardedCount;
+#else
+using ExpCount = long long;
+#endif
+
+/**
+ * @brief Operation counts of one exponentiation.
+ *
+ * Defining MONTGOMERY_NO_STATS (make STATS=0) turns the counts into
+ * DiscardedCount, removing the bookkeeping from the engines' inner loops.
+ */
+struct ExpCounters
+{
+    ExpCount squarings{};       ///< Squarings performed
+    ExpCount multiplications{}; ///< Non-squaring multiplications performed
+};
+
+/**
+ * @brief Human-readable engine name.
+ */
+inline const char *expEngineName(ExpEngine engine)
+{
+    switch (engine)
+    {
+    case ExpEngine::Binary:
+        return "binary";
+    case ExpEngine::FixedWindow:
+        return "fixed-window";
+    case ExpEngine::SlidingWindow:
+        return "sliding-window";
+    case ExpEngine::Ladder:
+        return "montgomery-ladder";
+    case ExpEngine::ConstantTimeWindow:
+        return "ct-fixed-window";
+    }
+    return "unknown";
+}
+
+/**
+ * @brief Parse an engine name as printed by expEngineName().
+ *
+ * @return true and sets engine on success, false for an unknown name
+ */
+inline bool parseExpEngine(const std::string &name, ExpEngine &engine)
+{
+    const ExpEngine all[] = {ExpEngine::Binary, ExpEngine::FixedWindow, ExpEngine::SlidingWindow,
+                             ExpEngine::Ladder, ExpEngine::ConstantTimeWindow};
+    for (ExpEngine candidate : all)
+    {
+        if (name == expEngineName(candidate))
+        {
+            engine = candidate;
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief Window size minimising the expected multiplication count for an exponent length.
+ *
+ * Thresholds balance the 2^(w-1) precomputed powers against the roughly
+ * bits/(w+1) multiplications saved.
+ */
+inline std::size_t chooseWindowBits(std::size_t exponentBits)
+{
+    if (exponentBits > 671)
+    {
+        return 6;
+    }
+    if (exponentBits > 239)
+    {
+        return 5;
+    }
+    if (exponentBits > 79)
+    {
+        return 4;
+    }
+    if (exponentBits > 23)
+    {
+        return 3;
+    }
+    return 1;
+}
+
+inline std::size_t exponentBitLength(std::uint64_t e)
+{
+    return e ? 64 - static_cast<std::size_t>(__builtin_clzll(e)) : 0;
+}
+
+inline bool exponentBit(std::uint64_t e, std::size_t i)
+{
+    return i < 64 && ((e >> i) & 1);
+}
+
+template <std::size_t Limbs>
+std::size_t exponentBitLength(const BigUInt<Limbs> &e)
+{
+    return e.bitLength();
+}
+
+template <std::size_t Limbs>
+bool exponentBit(const BigUInt<Limbs> &e, std::size_t i)
+{
+    return e.testBit(i);
+}
+
+/**
+ * @brief Width of the exponent type in bits.
+ *
+ * The constant-time engines always process this many bits, so their running
+ * time does not depend on the exponent's actual length.
+ */
+inline std::size_t exponentWidth(std::uint64_t)
+{
+    return 64;
+}
+
+template <std::size_t Limbs>
+std::size_t exponentWidth(const BigUInt<Limbs> &)
+{
+    return BigUInt<Limbs>::BITS;
+}
+
+/**
+ * @brief Swap a and b when mask is all ones; leave them when it is zero. Branch-free.
+ */
+inline void conditionalSwap(std::uint64_t &a, std::uint64_t &b, std::uint64_t mask)
+{
+    std::uint64_t t = (a ^ b) & mask;
+    a ^= t;
+    b ^= t;
+}
+
+template <std::size_t Limbs>
+void conditionalSwap(BigUInt<Limbs> &a, BigUInt<Limbs> &b, std::uint64_t mask)
+{
+    for (std::size_t i = 0; i < Limbs; ++i)
+    {
+        conditionalSwap(a[i], b[i], mask);
+    }
+}
+
+/**
+ * @brief dst = src when mask is all ones; unchanged when it is zero. Branch-free.
+ */
+inline void conditionalCopy(std::uint64_t &dst, const std::uint64_t &src, std::uint64_t mask)
+{
+    dst ^= (dst ^ src) & mask;
+}
+
+template <std::size_t Limbs>
+void conditionalCopy(BigUInt<Limbs> &dst, const BigUInt<Limbs> &src, std::uint64_t mask)
+{
+    for (std::size_t i = 0; i < Limbs; ++i)
+    {
+        conditionalCopy(dst[i], src[i], mask);
+    }
+}
+
+// w bits of e starting at bit 'low' (bits beyond the exponent read as zero)
+template <class Exponent>
+std::size_t exponentDigit(const Exponent &e, std::size_t low, std::size_t w)
+{
+    std::size_t digit = 0;
+    for (std::size_t k = w; k-- > 0;)
+    {
+        digit = (digit << 1) | (exponentBit(e, low + k) ? 1 : 0);
+    }
+    return digit;
+}
+
+/**
+ * @brief Right-to-left binary square-and-multiply.
+ *
+ * Squares the running power once per exponent bit (including the last) and
+ * multiplies it into the accumulator for every set bit.
+ */
+template <class Context, class Exponent>
+typename Context::Value expBinary(const Context &ctx, typename Context::Value base,
+                                  const Exponent &e, ExpCounters &counters)
+{
+    typename Context::Value acc = ctx.one();
+    std::size_t bits = exponentBitLength(e);
+    for (std::size_t i = 0; i < bits; ++i)
+    {
+        if (exponentBit(e, i))
+        {
+            acc = ctx.multiply(acc, base);
+            counters.multiplications++;
+        }
+        base = ctx.square(base);
+        counters.squarings++;
+    }
+    return acc;
+}
+
+/**
+ * @brief Left-to-right fixed-window (k-ary) exponentiation.
+ *
+ * Precomputes base^0 .. base^(2^w - 1), then for each w-bit digit of the
+ * exponent performs w squarings and, for a non-zero digit, one multiply.
+ */
+template <class Context, class Exponent>
+typename Context::Value expFixedWindow(const Context &ctx, const typename Context::Value &base,
+                                       const Exponent &e, std::size_t w, ExpCounters &counters)
+{
+    using Value = typename Context::Value;
+
+    std::size_t bits = exponentBitLength(e);
+    if (bits == 0)
+    {
+        return ctx.one();
+    }
+
+    std::array<Value, std::size_t(1) << MAX_WINDOW_BITS> table;
+    std::size_t size = std::size_t(1) << w;
+    table[0] = ctx.one();
+    table[1] = base;
+    for (std::size_t i = 2; i < size; ++i)
+    {
+        if (i % 2 == 0)
+        {
+            table[i] = ctx.square(table[i / 2]);
+            counters.squarings++;
+        }
+        else
+        {
+            table[i] = ctx.multiply(table[i - 1], base);
+            counters.multiplications++;
+        }
+    }
+
+    // The top digit initialises the accumulator without any squarings
+    std::size_t digits = (bits + w - 1) / w;
+    Value acc = table[exponentDigit(e, (digits - 1) * w, w)];
+    for (std::size_t d = digits - 1; d-- > 0;)
+    {
+        for (std::size_t k = 0; k < w; ++k)
+        {
+            acc = ctx.square(acc);
+            counters.squarings++;
+        }
+        std::size_t digit = exponentDigit(e, d * w, w);
+        if (digit != 0)
+        {
+            acc = ctx.multiply(acc, table[digit]);
+            counters.multiplications++;
+        }
+    }
+    return acc;
+}
+
+/**
+ * @brief Left-to-right sliding-window exponentiation over odd powers.
+ *
+ * Precomputes base^1, base^3, ..., base^(2^w - 1). Runs of zero bits cost
+ * one squaring each; every window (at most w bits, starting and ending
+ * with a 1) costs its squarings plus a single multiply by an odd power.
+ */
+template <class Context, class Exponent>
+typename Context::Value expSlidingWindow(const Context &ctx, const typename Context::Value &base,
+                                         const Exponent &e, std::size_t w, ExpCounters &counters)
+{
+    using Value = typename Context::Value;
+
+    std::size_t bits = exponentBitLength(e);
+    if (bits == 0)
+    {
+        return ctx.one();
+    }
+
+    // odd[k] = base^(2k+1)
+    std::array<Value, std::size_t(1) << (MAX_WINDOW_BITS - 1)> odd;
+    std::size_t oddCount = std::size_t(1) << (w - 1);
+    odd[0] = base;
+    if (oddCount > 1)
+    {
+        Value base2 = ctx.square(base);
+        counters.squarings++;
+        for (std::size_t k = 1; k < oddCount; ++k)
+        {
+            odd[k] = ctx.multiply(odd[k - 1], base2);
+            counters.multiplications++;
+        }
+    }
+
+    Value acc = ctx.one();
+    bool started = false; // acc is still 1: skip squaring and multiplying it
+    std::size_t i = bits;
+    while (i > 0)
+    {
+        if (!exponentBit(e, i - 1))
+        {
+            if (started)
+            {
+                acc = ctx.square(acc);
+                counters.squarings++;
+            }
+            --i;
+            continue;
+        }
+
+        // Longest window [low, i) of at most w bits whose lowest bit is set
+        std::size_t low = (i > w) ? i - w : 0;
+        while (!exponentBit(e, low))
+        {
+            ++low;
+        }
+        std::size_t length = i - low;
+        std::size_t digit = exponentDigit(e, low, length);
+
+        if (started)
+        {
+            for (std::size_t k = 0; k < length; ++k)
+            {
+                acc = ctx.square(acc);
+                counters.squarings++;
+            }
+            acc = ctx.multiply(acc, odd[digit >> 1]);
+            counters.multiplications++;
+        }
+        else
+        {
+            acc = odd[digit >> 1];
+            started = true;
+        }
+        i = low;
+    }
+    return acc;
+}
+
+/**
+ * @brief Constant-time Montgomery ladder.
+ *
+ * Keeps R0 = base^k and R1 = base^(k+1) for the exponent prefix k. Every one
+ * of the exponentWidth(e) bits costs exactly one multiply and one squaring,
+ * and the bit only drives a masked swap, so neither the operation sequence
+ * nor the memory access pattern depends on the exponent.
+ */
+template <class Context, class Exponent>
+typename Context::Value expLadder(const Context &ctx, const typename Context::Value &base,
+                                  const Exponent &e, ExpCounters &counters)
+{
+    using Value = typename Context::Value;
+
+    Value r0 = ctx.one();
+    Value r1 = base;
+    std::uint64_t previous = 0;
+    for (std::size_t i = exponentWidth(e); i-- > 0;)
+    {
+        std::uint64_t bit = exponentBit(e, i) ? 1 : 0;
+        // Swap only when the bit differs from the previous one
+        conditionalSwap(r0, r1, 0 - (bit ^ previous));
+        previous = bit;
+
+        r1 = ctx.multiply(r0, r1);
+        r0 = ctx.square(r0);
+        counters.multiplications++;
+        counters.squarings++;
+    }
+    conditionalSwap(r0, r1, 0 - previous);
+    return r0;
+}
+
+/**
+ * @brief Constant-time fixed-window exponentiation.
+ *
+ * Like expFixedWindow() but processes all exponentWidth(e) bits, always
+ * multiplies (digit 0 multiplies by one), and reads each table entry through
+ * a scan of the whole table, so the entry selected by a secret digit is never
+ * used as a memory address. Costs (1 + 1/w) operations per bit.
+ */
+template <class Context, class Exponent>
+typename Context::Value expConstantTimeWindow(const Context &ctx,
+                                              const typename Context::Value &base,
+                                              const Exponent &e, std::size_t w,
+                                              ExpCounters &counters)
+{
+    using Value = typename Context::Value;
+
+    std::array<Value, std::size_t(1) << MAX_WINDOW_BITS> table;
+    std::size_t size = std::size_t(1) << w;
+    table[0] = ctx.one();
+    table[1] = base;
+    for (std::size_t i = 2; i < size; ++i)
+    {
+        table[i] = ctx.multiply(table[i - 1], base);
+        counters.multiplications++;
+    }
+
+    std::size_t digits = (exponentWidth(e) + w - 1) / w;
+    Value acc = ctx.one();
+    for (std::size_t d = digits; d-- > 0;)
+    {
+        if (d + 1 < digits)
+        {
+            for (std::size_t k = 0; k < w; ++k)
+            {
+                acc = ctx.square(acc);
+                counters.squarings++;
+            }
+        }
+
+        std::uint64_t digit = exponentDigit(e, d * w, w);
+        Value selected = table[0];
+        for (std::size_t i = 1; i < size; ++i)
+        {
+            // All ones exactly when i == digit, computed without a comparison branch
+            std::uint64_t diff = static_cast<std::uint64_t>(i) ^ digit;
+            std::uint64_t mask = ((diff | (0 - diff)) >> 63) - 1;
+            conditionalCopy(selected, table[i], mask);
+        }
+        acc = ctx.multiply(acc, selected);
+        counters.multiplications++;
+    }
+    return acc;
+}
+
+/**
+ * @brief Window size an engine will use, or 0 for the engines without a window.
+ *
+ * @param windowBits Requested size; 0 picks it from the exponent length (the
+ *                   exponent width for ConstantTimeWindow) with chooseWindowBits().
+ */
+template <class Exponent>
+std::size_t resolveWindowBits(ExpEngine engine, std::size_t windowBits, const Exponent &e)
+{
+    switch (engine)
+    {
+    case ExpEngine::Binary:
+    case ExpEngine::Ladder:
+        return 0;
+    case ExpEngine::ConstantTimeWindow:
+        // Must not look at the secret exponent's actual length
+        windowBits = windowBits ? windowBits : chooseWindowBits(exponentWidth(e));
+        break;
+    default:
+        windowBits = windowBits ? windowBits : chooseWindowBits(exponentBitLength(e));
+        break;
+    }
+    return windowBits > MAX_WINDOW_BITS ? MAX_WINDOW_BITS : windowBits;
+}
+
+/**
+ * @brief Run the selected engine.
+ *
+ * @param windowBits Window size for the windowed engines (see resolveWindowBits())
+ */
+template <class Context, class Exponent>
+typename Context::Value exponentiate(const Context &ctx, const typename Context::Value &base,
+                                     const Exponent &e, ExpEngine engine, std::size_t windowBits,
+                                     ExpCounters &counters)
+{
+    std::size_t w = resolveWindowBits(engine, windowBits, e);
+
+    switch (engine)
+    {
+    case ExpEngine::Binary:
+        return expBinary(ctx, base, e, counters);
+    case ExpEngine::FixedWindow:
+        return expFixedWindow(ctx, base, e, w, counters);
+    case ExpEngine::Ladder:
+        return expLadder(ctx, base, e, counters);
+    case ExpEngine::ConstantTimeWindow:
+        return expConstantTimeWindow(ctx, base, e, w, counters);
+    case ExpEngine::SlidingWindow:
+    default:
+        return expSlidingWindow(ctx, base, e, w, counters);
+    }
+}
+
+#endif // EXP_ENGINES_H
@@ -0,0 +1,138 @@
+#ifndef EXP_STATS_H
+#define EXP_STATS_H
+
+#include "exp_engines.hpp"
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#if !defined(MONTGOMERY_NO_STATS) && (defined(__x86_64__) || defined(__i386__))
+#include <x86intrin.h>
+#define MONTGOMERY_HAVE_RDTSC 1
+#endif
+
+/**
+ * @brief Measurements of the last exponentiation (or batch) of an engine.
+ *
+ * A product is one squaring or one multiplication; reductions also include
+ * the conversions into and out of Montgomery form (each is one REDC, or one
+ * '%' with PlainModularContext). With MONTGOMERY_NO_STATS defined every
+ * field except engine, windowBits, exponentBits and operations stays zero.
+ */
+struct ExpStats
+{
+    ExpEngine engine = ExpEngine::SlidingWindow; ///< Engine that ran
+    std::size_t windowBits = 0;        ///< Window used; 0 for unwindowed or per-operand windows
+    std::size_t exponentBits = 0;      ///< Bit length of the (longest) exponent
+    std::size_t operations = 0;        ///< Exponentiations measured (batch size)
+    long long squarings = 0;           ///< Squarings
+    long long multiplications = 0;     ///< Non-squaring multiplications
+    long long reductions = 0;          ///< Modular reductions, conversions included
+    long long elapsedNanoseconds = 0;  ///< Wall-clock time
+    std::uint64_t cycles = 0;          ///< Time-stamp counter ticks; 0 where rdtsc is unavailable
+
+    /**
+     * @brief Squarings plus multiplications.
+     */
+    long long products() const { return squarings + multiplications; }
+
+    /**
+     * @brief Single-line JSON object with every field.
+     */
+    std::string toJson() const;
+};
+
+/**
+ * @brief Whether operation counts and timings are collected in this build.
+ */
+constexpr bool expStatsEnabled()
+{
+#ifdef MONTGOMERY_NO_STATS
+    return false;
+#else
+    return true;
+#endif
+}
+
+/**
+ * @class StatsTimer
+ * @brief Wall-clock and time-stamp counter stopwatch started at construction.
+ *
+ * Compiles to nothing with MONTGOMERY_NO_STATS.
+ */
+class StatsTimer
+{
+public:
+    StatsTimer()
+    {
+#ifndef MONTGOMERY_NO_STATS
+        start_ = std::chrono::steady_clock::now();
+#ifdef MONTGOMERY_HAVE_RDTSC
+        startCycles_ = __rdtsc();
+#endif
+#endif
+    }
+
+    /**
+     * @brief Store the time elapsed since construction into stats.
+     */
+    void stop(ExpStats &stats) const
+    {
+#ifndef MONTGOMERY_NO_STATS
+#ifdef MONTGOMERY_HAVE_RDTSC
+        stats.cycles = __rdtsc() - startCycles_;
+#endif
+        stats.elapsedNanoseconds = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                       std::chrono::steady_clock::now() - start_)
+                                       .count();
+#else
+        (void)stats;
+#endif
+    }
+
+private:
+#ifndef MONTGOMERY_NO_STATS
+    std::chrono::steady_clock::time_point start_;
+#ifdef MONTGOMERY_HAVE_RDTSC
+    std::uint64_t startCycles_ = 0;
+#endif
+#endif
+};
+
+/**
+ * @brief Exponent size to report: the bit length, or for the constant-time
+ *        engines the width they process (the bit length is secret there).
+ */
+template <class Exponent>
+std::size_t statsExponentBits(ExpEngine engine, const Exponent &e)
+{
+    bool constantTime = engine == ExpEngine::Ladder || engine == ExpEngine::ConstantTimeWindow;
+    return constantTime ? exponentWidth(e) : exponentBitLength(e);
+}
+
+/**
+ * @brief Stats record for one exponentiation, before counters and time are filled in.
+ */
+template <class Exponent>
+ExpStats makeExpStats(ExpEngine engine, std::size_t windowBits, const Exponent &e)
+{
+    ExpStats stats;
+    stats.engine = engine;
+    stats.windowBits = resolveWindowBits(engine, windowBits, e);
+    stats.exponentBits = statsExponentBits(engine, e);
+    stats.operations = 1;
+    return stats;
+}
+
+/**
+ * @brief Copy engine counters into stats; conversions adds the to/from Montgomery reductions.
+ */
+inline void recordCounters(ExpStats &stats, const ExpCounters &counters, long long conversions)
+{
+    stats.squarings = counters.squarings;
+    stats.multiplications = counters.multiplications;
+    stats.reductions = expStatsEnabled() ? stats.products() + conversions : 0;
+}
+
+#endif // EXP_STATS_H
@@ -0,0 +1,139 @@
+#ifndef FERMAT_INVERSE_HPP
+#define FERMAT_INVERSE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include "binary_gcd.hpp"
+#include "exp_engines.hpp"
+#include "montgomery_big.hpp"
+#include "montgomery_context.hpp"
+#include "safegcd.hpp"
+
+/**
+ * @file fermat_inverse.hpp
+ * @brief Modular inverse by Fermat's little theorem on the Montgomery engine.
+ *
+ * For a prime p and x not divisible by p, x^(p-1) ≡ 1 (mod p), so x^(p-2) is
+ * the inverse of x. The power is computed in Montgomery form with the
+ * contexts of libnumtheory (MontgomeryContext for 63-bit moduli,
+ * BigMontgomeryContext above). The exponent p - 2 is public and the
+ * Montgomery products are branch-free, so the running time does not depend
+ * on x.
+ *
+ * The result is checked with one more product: x·x^(p-2) ≡ 1 (mod p) proves
+ * it is the inverse whether or not p is actually prime. A wrong primality
+ * hint therefore costs a wasted exponentiation, never a wrong answer.
+ */
+
+/**
+ * @brief What the caller knows about a modulus, e.g. from a cached primality test.
+ */
+enum class ModulusHint
+{
+    Unknown, ///< No information: use the selected GCD engine
+    Prime    ///< The modulus is (believed to be) prime: try x^(p-2) mod p first
+};
+
+/**
+ * @brief Computes x^(p-2) mod p for a word-sized odd p and checks that it inverts x.
+ *
+ * @param[in] x The residue, 0 <= x < p.
+ * @param[in] p The odd modulus, 3 <= p < 2^63.
+ * @param[out] inverse Receives x^(p-2) mod p if it is the inverse of x.
+ * @return true if x·x^(p-2) ≡ 1 (mod p).
+ */
+inline bool fermat_inverse(std::uint64_t x, std::uint64_t p, std::uint64_t &inverse)
+{
+    MontgomeryContext ctx(p);
+    ExpCounters counters;
+    std::uint64_t base = ctx.toMontgomery(x);
+    std::uint64_t power = exponentiate(ctx, base, p - 2, ExpEngine::SlidingWindow, 0, counters);
+    if (ctx.multiply(base, power) != ctx.one())
+        return false;
+    inverse = ctx.fromMontgomery(power);
+    return true;
+}
+
+/**
+ * @brief Multi-limb counterpart of fermat_inverse() for an odd p >= 3.
+ */
+template <std::size_t Limbs>
+bool fermat_inverse(const BigUInt<Limbs> &x, const BigUInt<Limbs> &p, BigUInt<Limbs> &inverse)
+{
+    BigMontgomeryContext<Limbs> ctx(p);
+    ExpCounters counters;
+    BigUInt<Limbs> base = ctx.toMontgomery(x);
+    BigUInt<Limbs> power =
+        exponentiate(ctx, base, p - BigUInt<Limbs>(2), ExpEngine::SlidingWindow, 0, counters);
+    if (ctx.multiply(base, power) != ctx.one())
+        return false;
+    inverse = ctx.fromMontgomery(power);
+    return true;
+}
+
+/**
+ * @name Unsigned magnitudes routed to the word or multi-limb fermat_inverse()
+ * @{
+ */
+inline bool fermat_inverse(unsigned long long x, unsigned long long p, unsigned long long &inverse)
+{
+    std::uint64_t word = 0;
+    if (!fermat_inverse(std::uint64_t(x), std::uint64_t(p), word))
+        return false;
+    inverse = word;
+    return true;
+}
+
+inline bool fermat_inverse(unsigned int x, unsigned int p, unsigned int &inverse)
+{
+    std::uint64_t word = 0;
+    if (!fermat_inverse(std::uint64_t(x), std::uint64_t(p), word))
+        return false;
+    inverse = static_cast<unsigned int>(word);
+    return true;
+}
+
+inline bool fermat_inverse(unsigned __int128 x, unsigned __int128 p, unsigned __int128 &inverse)
+{
+    BigUInt<2> wide;
+    if (!fermat_inverse(to_big_uint(x), to_big_uint(p), wide))
+        return false;
+    from_big_uint(wide, inverse);
+    return true;
+}
+/** @} */
+
+/**
+ * @brief Finds the Modular Inverse of x modulo a prime y as x^(y-2) mod y.
+ *
+ * An x outside [0, y) is first reduced with '%', which is not constant time.
+ * Fails for even y, for y < 3, and whenever the result does not invert x:
+ * x ≡ 0, or y composite and not a Fermat pseudoprime to base x.
+ *
+ * @tparam T A signed integer type: int32_t, int64_t, __int128 or BigInt<Limbs>.
+ * @param[in] x The integer whose modular inverse is to be found.
+ * @param[in] y The modulus, expected to be prime.
+ * @param[out] inverse Receives the modular inverse of x modulo y in [0, y) on success.
+ * @return true if inverse was set.
+ */
+template <typename T>
+bool fermat_mod_inverse(T x, T y, T &inverse)
+{
+    using U = typename unsigned_magnitude<T>::type;
+    if (y < T(3) || !is_odd(to_magnitude(y)))
+        return false;
+    if (x < T(0) || x >= y)
+    {
+        x = x % y;
+        if (x < T(0))
+            x = x + y;
+    }
+
+    U magnitude = to_magnitude(x);
+    if (!fermat_inverse(to_magnitude(x), to_magnitude(y), magnitude))
+        return false;
+    inverse = from_magnitude<T>(magnitude);
+    return true;
+}
+
+#endif // FERMAT_INVERSE_HPP
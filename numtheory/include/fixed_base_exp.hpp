@@ -0,0 +1,223 @@
+#ifndef FIXED_BASE_EXP_H
+#define FIXED_BASE_EXP_H
+
+#include "exp_engines.hpp"
+#include "montgomery_context.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <variant>
+#include <vector>
+
+/** @brief Largest window accepted by BasicFixedBaseExp (table rows of 4095 entries). */
+constexpr std::size_t FIXED_BASE_MAX_WINDOW_BITS = 12;
+
+/** @brief Window used when none is given: 15 entries per row, bits/4 multiplications. */
+constexpr std::size_t FIXED_BASE_DEFAULT_WINDOW_BITS = 4;
+
+/**
+ * @class BasicFixedBaseExp
+ * @brief Exponentiation of one fixed base g modulo n with a precomputed power table.
+ *
+ * Splits exponents of up to maxExponentBits bits into w-bit digits
+ * e = sum d_i·2^(w·i) and stores every g^(d·2^(w·i)), so
+ *
+ *     g^e = prod_i table[i][d_i]
+ *
+ * costs at most one multiplication per non-zero digit (about bits/w) and no
+ * squarings. The table holds ceil(bits/w)·(2^w - 1) values, which is the
+ * memory/speed tradeoff chosen with w; building it costs about as many
+ * multiplications as it has entries.
+ *
+ * Works with any context exposing the MontgomeryContext interface
+ * (MontgomeryContext, PlainModularContext, BigMontgomeryContext<Limbs>).
+ * Running time depends on the exponent's digits, so this is not for secret
+ * exponents that need constant-time treatment.
+ */
+template <class Context, class Exponent = typename Context::Value>
+class BasicFixedBaseExp
+{
+public:
+    using Value = typename Context::Value;
+
+    /**
+     * @brief Build the power table for base modulo ctx.modulus().
+     *
+     * @param ctx Context of the modulus (copied)
+     * @param base The fixed base, as an ordinary residue
+     * @param maxExponentBits Longest exponent compute() will accept, >= 1
+     * @param windowBits Digit width w (1..FIXED_BASE_MAX_WINDOW_BITS);
+     *                   0 selects FIXED_BASE_DEFAULT_WINDOW_BITS
+     * @throws std::invalid_argument if maxExponentBits or windowBits is out of range
+     */
+    BasicFixedBaseExp(const Context &ctx, const Value &base, std::size_t maxExponentBits,
+                      std::size_t windowBits = 0)
+        : ctx_(ctx),
+          w_(windowBits ? windowBits : FIXED_BASE_DEFAULT_WINDOW_BITS),
+          maxBits_(maxExponentBits),
+          result_(),
+          multiplicationCount_(0)
+    {
+        if (maxBits_ == 0)
+        {
+            throw std::invalid_argument("BasicFixedBaseExp: maxExponentBits must be positive");
+        }
+        if (w_ > FIXED_BASE_MAX_WINDOW_BITS)
+        {
+            throw std::invalid_argument("BasicFixedBaseExp: window too large");
+        }
+
+        digits_ = (maxBits_ + w_ - 1) / w_;
+        rowSize_ = (std::size_t(1) << w_) - 1;
+        table_.resize(digits_ * rowSize_);
+
+        // Row i starts at g^(2^(w·i)) = (last entry of row i-1) · (first entry of row i-1)
+        Value rowBase = ctx_.toMontgomery(base);
+        for (std::size_t i = 0; i < digits_; ++i)
+        {
+            Value *row = &table_[i * rowSize_];
+            row[0] = rowBase;
+            for (std::size_t j = 1; j < rowSize_; ++j)
+            {
+                row[j] = ctx_.multiply(row[j - 1], rowBase);
+                precomputeMultiplications_++;
+            }
+            if (i + 1 < digits_)
+            {
+                rowBase = ctx_.multiply(row[rowSize_ - 1], rowBase);
+                precomputeMultiplications_++;
+            }
+        }
+    }
+
+    /**
+     * @brief Compute base^e mod n.
+     *
+     * @param e Exponent of at most maxExponentBits() bits
+     * @return Value The result as an ordinary residue
+     * @throws std::invalid_argument if e is longer than maxExponentBits()
+     */
+    Value compute(const Exponent &e)
+    {
+        if (exponentBitLength(e) > maxBits_)
+        {
+            throw std::invalid_argument("BasicFixedBaseExp::compute: exponent too long");
+        }
+
+        long long multiplications = 0;
+        bool started = false;
+        Value acc = ctx_.one();
+        for (std::size_t i = 0; i < digits_; ++i)
+        {
+            std::size_t digit = exponentDigit(e, i * w_, w_);
+            if (digit == 0)
+            {
+                continue;
+            }
+            const Value &entry = table_[i * rowSize_ + digit - 1];
+            if (started)
+            {
+                acc = ctx_.multiply(acc, entry);
+                multiplications++;
+            }
+            else
+            {
+                acc = entry;
+                started = true;
+            }
+        }
+        multiplicationCount_ = multiplications;
+        result_ = ctx_.fromMontgomery(acc);
+        return result_;
+    }
+
+    const Context &context() const { return ctx_; }
+
+    std::size_t windowBits() const { return w_; }
+
+    std::size_t maxExponentBits() const { return maxBits_; }
+
+    /** @brief Number of precomputed values held. */
+    std::size_t tableEntries() const { return table_.size(); }
+
+    /** @brief Multiplications spent building the table. */
+    long long getPrecomputeMultiplications() const { return precomputeMultiplications_; }
+
+    const Value &getResult() const { return result_; }
+
+    /** @brief Multiplications performed by the last compute(). */
+    long long getMultiplicationCount() const { return multiplicationCount_; }
+
+private:
+    Context ctx_;                             ///< Modulus context
+    std::size_t w_;                           ///< Digit width in bits
+    std::size_t maxBits_;                     ///< Longest accepted exponent
+    std::size_t digits_ = 0;                  ///< Rows in the table, ceil(maxBits_ / w_)
+    std::size_t rowSize_ = 0;                 ///< Entries per row, 2^w - 1
+    std::vector<Value> table_;                ///< table_[i·rowSize_ + d-1] = g^(d·2^(w·i))
+    Value result_;                            ///< Result of the last compute()
+    long long multiplicationCount_;           ///< Multiplications in the last compute()
+    long long precomputeMultiplications_ = 0; ///< Multiplications spent on the table
+};
+
+/**
+ * @class FixedBaseExp
+ * @brief Fixed-base counterpart of MontgomeryExp for 63-bit operands.
+ *
+ * Builds the table for (g, n) once; each compute(b) then returns g^b mod n
+ * with about 63/w multiplications. Odd moduli use MontgomeryContext and even
+ * moduli PlainModularContext, as in MontgomeryExp::compute().
+ */
+class FixedBaseExp
+{
+public:
+    /**
+     * @brief Precompute the power table of g modulo n.
+     *
+     * @param g Base; negative bases are reduced into [0, n)
+     * @param n Modulus, n > 0
+     * @param windowBits Digit width (see BasicFixedBaseExp); 0 for the default
+     * @throws std::invalid_argument if n <= 0 or windowBits is too large
+     */
+    FixedBaseExp(long long g, long long n, std::size_t windowBits = 0);
+
+    /**
+     * @brief Compute (g^b) mod n.
+     *
+     * @param b Exponent, b >= 0
+     * @return long long The result
+     * @throws std::invalid_argument if b < 0
+     */
+    long long compute(long long b);
+
+    /**
+     * @brief Prints the last result and statistics to standard output.
+     *
+     * @param b The exponent of the last compute()
+     */
+    void printStats(long long b) const;
+
+    long long getBase() const;
+
+    long long getModulus() const;
+
+    std::size_t getWindowBits() const;
+
+    /** @brief Number of precomputed values held. */
+    std::size_t getTableEntries() const;
+
+    long long getResult() const;
+
+    /** @brief Multiplications performed by the last compute(). */
+    long long getMultiplicationCount() const;
+
+private:
+    using MontgomeryTable = BasicFixedBaseExp<MontgomeryContext>;
+    using PlainTable = BasicFixedBaseExp<PlainModularContext>;
+
+    long long g_;                                     ///< Base, reduced into [0, n)
+    long long n_;                                     ///< Modulus
+    std::variant<MontgomeryTable, PlainTable> table_; ///< Table for an odd or even modulus
+};
+
+#endif // FIXED_BASE_EXP_H
@@ -0,0 +1,117 @@
+#ifndef GCD_HPP
+#define GCD_HPP
+
+/**
+ * @brief Result of the Extended Euclidean Algorithm: gcd = a*x + b*y.
+ *
+ * @tparam T The integer type of the operands.
+ */
+template <typename T>
+struct ExtendedGcdResult
+{
+    T gcd; ///< The GCD of a and b (non-negative).
+    T x;   ///< The coefficient of a in Bézout's identity.
+    T y;   ///< The coefficient of b in Bézout's identity.
+};
+
+/**
+ * @brief Computes q = a / b and r = a % b.
+ *
+ * The generic version uses the type's operators. Types with a combined
+ * division (such as BigInt) provide a more specialised divmod() overload,
+ * which the algorithms below pick up so each step divides only once.
+ */
+template <typename T>
+void divmod(const T &a, const T &b, T &q, T &r)
+{
+    q = a / b;
+    r = a % b;
+}
+
+/**
+ * @brief Absolute value for any signed integer type, including __int128 and BigInt.
+ */
+template <typename T>
+T magnitude(const T &value)
+{
+    return value < T(0) ? T(0) - value : value;
+}
+
+/**
+ * @brief Computes the Greatest Common Divisor (GCD) of two integers using the Euclidean Algorithm.
+ *
+ * This function implements the Euclidean Algorithm to find the GCD of two integers.
+ * The GCD of two integers is the largest integer that divides both of them without leaving a remainder.
+ * Works for any signed integer type T (int, long long, __int128, BigInt<Limbs>); the result is
+ * non-negative.
+ *
+ * @param[in] a The first integer.
+ * @param[in] b The second integer.
+ * @return The GCD of a and b.
+ */
+template <typename T>
+T gcd(T a, T b)
+{
+    a = magnitude(a);
+    b = magnitude(b);
+    T q, r;
+    while (b != T(0))
+    {
+        divmod(a, b, q, r);
+        a = b;
+        b = r;
+    }
+    return a;
+}
+
+/**
+ * @brief Computes the Extended Euclidean Algorithm.
+ *
+ * This function calculates the GCD of two integers, a and b, and also finds coefficients x and y
+ * that satisfy Bézout's identity: \f$ ax + by = \text{gcd}(a, b) \f$.
+ * The Extended Euclidean Algorithm is useful for applications such as finding modular inverses.
+ *
+ * The algorithm is iterative: it keeps the remainder sequence and both coefficient sequences
+ * in local variables, so it uses constant stack space and needs one division per step. Every
+ * intermediate coefficient is bounded by max(|a|, |b|) / gcd(a, b), so nothing overflows for
+ * any operands representable in T (except the type's minimum value, whose magnitude is not).
+ *
+ * @tparam T A signed integer type: int32_t, int64_t, __int128 or BigInt<Limbs>.
+ * @param[in] a The first integer.
+ * @param[in] b The second integer.
+ * @return The GCD of a and b with the coefficients x and y.
+ */
+template <typename T>
+ExtendedGcdResult<T> extended_gcd(T a, T b)
+{
+    bool negative_a = a < T(0);
+    bool negative_b = b < T(0);
+
+    // Invariant: old_r = |a|*old_x + |b|*old_y and r = |a|*x + |b|*y
+    T old_r = magnitude(a), r = magnitude(b);
+    T old_x = T(1), x = T(0);
+    T old_y = T(0), y = T(1);
+    T q, next;
+    while (r != T(0))
+    {
+        divmod(old_r, r, q, next);
+        old_r = r;
+        r = next;
+
+        next = old_x - q * x;
+        old_x = x;
+        x = next;
+
+        next = old_y - q * y;
+        old_y = y;
+        y = next;
+    }
+
+    ExtendedGcdResult<T> result;
+    result.gcd = old_r;
+    result.x = negative_a ? T(0) - old_x : old_x;
+    result.y = negative_b ? T(0) - old_y : old_y;
+    return result;
+}
+
+#endif // GCD_HPP
@@ -0,0 +1,132 @@
+#ifndef GCD_ENGINE_HPP
+#define GCD_ENGINE_HPP
+
+#include <string>
+#include "binary_gcd.hpp"
+#include "fermat_inverse.hpp"
+#include "gcd.hpp"
+#include "lehmer_gcd.hpp"
+#include "mod_inverse.hpp"
+#include "safegcd.hpp"
+
+/**
+ * @brief Algorithms available for gcd() and mod_inverse().
+ */
+enum class GcdEngine
+{
+    Euclidean, ///< Remainder sequence: one division per step
+    Binary,    ///< Stein's algorithm: trailing-zero counts, shifts and subtractions only
+    Lehmer,    ///< Leading-word steps batched into a cofactor matrix (multi-limb integers)
+    SafeGcd    ///< Constant-time Bernstein–Yang divsteps (inverses modulo odd numbers)
+};
+
+/**
+ * @brief Returns the command-line name of an engine ("euclidean", "binary", "lehmer" or "safegcd").
+ */
+inline const char *gcd_engine_name(GcdEngine engine)
+{
+    switch (engine)
+    {
+    case GcdEngine::Binary:
+        return "binary";
+    case GcdEngine::Lehmer:
+        return "lehmer";
+    case GcdEngine::SafeGcd:
+        return "safegcd";
+    default:
+        return "euclidean";
+    }
+}
+
+/**
+ * @brief Parses an engine name as printed by gcd_engine_name().
+ *
+ * @param[in] name The engine name.
+ * @param[out] engine Receives the engine if the name is known.
+ * @return true if the name was recognised.
+ */
+inline bool parse_gcd_engine(const std::string &name, GcdEngine &engine)
+{
+    if (name == "euclidean")
+        engine = GcdEngine::Euclidean;
+    else if (name == "binary")
+        engine = GcdEngine::Binary;
+    else if (name == "lehmer")
+        engine = GcdEngine::Lehmer;
+    else if (name == "safegcd")
+        engine = GcdEngine::SafeGcd;
+    else
+        return false;
+    return true;
+}
+
+/**
+ * @brief Computes the GCD of a and b with the selected engine.
+ *
+ * Lehmer's algorithm only differs from the Euclidean one for BigInt operands.
+ * The safegcd engine only provides inverses; its GCD is the Euclidean one.
+ */
+template <typename T>
+T gcd(T a, T b, GcdEngine engine)
+{
+    switch (engine)
+    {
+    case GcdEngine::Binary:
+        return binary_gcd(a, b);
+    case GcdEngine::Lehmer:
+        return lehmer_gcd(a, b);
+    default:
+        return gcd(a, b);
+    }
+}
+
+/**
+ * @brief Computes the Extended Euclidean Algorithm with the selected engine.
+ *
+ * The binary and safegcd engines have no general Bézout variant, so they run the
+ * Euclidean one.
+ */
+template <typename T>
+ExtendedGcdResult<T> extended_gcd(T a, T b, GcdEngine engine)
+{
+    return engine == GcdEngine::Lehmer ? lehmer_extended_gcd(a, b) : extended_gcd(a, b);
+}
+
+/**
+ * @brief Finds the Modular Inverse of x modulo y with the selected engine.
+ *
+ * The binary and safegcd variants halve coefficients modulo y and therefore
+ * need an odd modulus; with those engines, even moduli take the Euclidean path
+ * (which is not constant time).
+ *
+ * @return The modular inverse of x modulo y in [0, y) if it exists; otherwise, -1.
+ */
+template <typename T>
+T mod_inverse(T x, T y, GcdEngine engine)
+{
+    if (engine == GcdEngine::Binary && is_odd(to_magnitude(y)))
+        return binary_mod_inverse(x, y);
+    if (engine == GcdEngine::SafeGcd && is_odd(to_magnitude(y)))
+        return safegcd_mod_inverse(x, y);
+    return inverse_from_bezout(extended_gcd(x, y, engine), y);
+}
+
+/**
+ * @brief Finds the Modular Inverse of x modulo y, using what is known about y.
+ *
+ * With ModulusHint::Prime, the inverse is first computed as x^(y-2) mod y on
+ * the Montgomery engine (see fermat_mod_inverse()). Only if that fails, for
+ * an even y, x ≡ 0, or a wrong hint, the selected engine computes it instead.
+ *
+ * @return The modular inverse of x modulo y in [0, y) if it exists; otherwise, -1.
+ */
+template <typename T>
+T mod_inverse(T x, T y, GcdEngine engine, ModulusHint hint)
+{
+    T inverse;
+    if (hint == ModulusHint::Prime && fermat_mod_inverse(x, y, inverse))
+        return inverse;
+    return mod_inverse(x, y, engine);
+}
+
+#endif // GCD_ENGINE_HPP
@@ -0,0 +1,252 @@
+#ifndef LEHMER_GCD_HPP
+#define LEHMER_GCD_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include "big_int.hpp"
+#include "gcd.hpp"
+
+/**
+ * @brief 2x2 cofactor matrix accumulated from leading-word Euclidean steps.
+ *
+ * Applied to (a, b) it yields (A·a + B·b, C·a + D·b). Each row holds one
+ * non-negative and one non-positive entry, and every magnitude is below 2^63.
+ */
+struct LehmerCofactors
+{
+    std::int64_t A = 1, B = 0; ///< Row producing the new a
+    std::int64_t C = 0, D = 1; ///< Row producing the new b
+};
+
+/**
+ * @brief Simulates Euclidean steps on the leading 63 bits of a >= b (Knuth's Algorithm L).
+ *
+ * a_hat and b_hat are a and b shifted right by the same amount. A step is
+ * accepted only if the quotient is the same at both ends of the uncertainty
+ * interval. It is then the quotient the full-precision numbers would produce.
+ *
+ * @param[in] a_hat Leading bits of a (below 2^63).
+ * @param[in] b_hat The same bits of b.
+ * @return The accumulated cofactors; B == 0 means no step could be taken.
+ */
+inline LehmerCofactors lehmer_cofactors(std::int64_t a_hat, std::int64_t b_hat)
+{
+    LehmerCofactors m;
+    // Sums are formed in 128 bits: a_hat + A can exceed 2^63 before the quotient test rejects it
+    __int128 x = a_hat, y = b_hat;
+    while (y + m.C > 0 && y + m.D > 0)
+    {
+        __int128 q = (x + m.A) / (y + m.C);
+        if (q != (x + m.B) / (y + m.D))
+            break;
+
+        __int128 t = m.A - q * m.C;
+        m.A = m.C;
+        m.C = static_cast<std::int64_t>(t);
+        t = m.B - q * m.D;
+        m.B = m.D;
+        m.D = static_cast<std::int64_t>(t);
+        t = x - q * y;
+        x = y;
+        y = t;
+    }
+    return m;
+}
+
+/**
+ * @brief value · factor for a single-limb factor (the product wraps like BigUInt).
+ */
+template <std::size_t Limbs>
+BigUInt<Limbs> scale(BigUInt<Limbs> value, std::uint64_t factor)
+{
+    value.mulAddSmall(factor, 0);
+    return value;
+}
+
+/**
+ * @brief |value| as an unsigned 64-bit number, valid for INT64_MIN as well.
+ */
+inline std::uint64_t abs_u64(std::int64_t value)
+{
+    return value < 0 ? 0 - static_cast<std::uint64_t>(value) : static_cast<std::uint64_t>(value);
+}
+
+/**
+ * @brief p·u + q·v for remainders, where p and q have opposite signs (or one is zero).
+ *
+ * The true result lies in [0, 2^(64·Limbs)), so the wrap-around of the two
+ * products cancels in the subtraction and the result is exact.
+ */
+template <std::size_t Limbs>
+BigUInt<Limbs> combine_remainders(std::int64_t p, const BigUInt<Limbs> &u, std::int64_t q,
+                                  const BigUInt<Limbs> &v)
+{
+    BigUInt<Limbs> pu = scale(u, abs_u64(p));
+    BigUInt<Limbs> qv = scale(v, abs_u64(q));
+    return p >= 0 && q <= 0 ? pu - qv : qv - pu;
+}
+
+/**
+ * @brief p·u + q·v for Bézout coefficients.
+ *
+ * The two products have the same sign (consecutive coefficients alternate in
+ * sign, as do the entries of a cofactor row), so neither exceeds the result.
+ */
+template <std::size_t Limbs>
+BigInt<Limbs> combine_coefficients(std::int64_t p, const BigInt<Limbs> &u, std::int64_t q,
+                                   const BigInt<Limbs> &v)
+{
+    BigInt<Limbs> pu(scale(u.magnitude(), abs_u64(p)), (p < 0) != u.isNegative());
+    BigInt<Limbs> qv(scale(v.magnitude(), abs_u64(q)), (q < 0) != v.isNegative());
+    return pu + qv;
+}
+
+/**
+ * @brief Leading bits of a and the same bits of b, so that the a part fits in 63 bits.
+ */
+template <std::size_t Limbs>
+std::pair<std::int64_t, std::int64_t> leading_bits(const BigUInt<Limbs> &a,
+                                                   const BigUInt<Limbs> &b)
+{
+    std::size_t bits = a.bitLength();
+    std::size_t shift = bits > 63 ? bits - 63 : 0;
+    BigUInt<Limbs> a_top = a;
+    BigUInt<Limbs> b_top = b;
+    a_top.shiftRight(shift);
+    b_top.shiftRight(shift);
+    return {static_cast<std::int64_t>(a_top[0]), static_cast<std::int64_t>(b_top[0])};
+}
+
+/**
+ * @brief Computes the GCD of two multi-limb integers with Lehmer's algorithm.
+ *
+ * Each round runs as many Euclidean steps as the leading 63 bits determine.
+ * Those steps use 64-bit arithmetic only, and their 2x2 cofactor matrix is then
+ * applied to the full numbers with single-limb multiplications. One bignum
+ * division is needed only when the leading bits cannot decide a quotient
+ * (typically a very large one). Once both numbers fit in a single limb the
+ * remaining steps use the plain Euclidean loop.
+ *
+ * @param[in] a The first integer.
+ * @param[in] b The second integer.
+ * @return The GCD of a and b (non-negative).
+ */
+template <std::size_t Limbs>
+BigInt<Limbs> lehmer_gcd(const BigInt<Limbs> &a, const BigInt<Limbs> &b)
+{
+    BigUInt<Limbs> u = a.magnitude();
+    BigUInt<Limbs> v = b.magnitude();
+    if (u < v)
+        std::swap(u, v);
+
+    BigUInt<Limbs> q, r;
+    while (v.bitLength() > 64)
+    {
+        std::pair<std::int64_t, std::int64_t> top = leading_bits(u, v);
+        LehmerCofactors m = lehmer_cofactors(top.first, top.second);
+        if (m.B == 0)
+        {
+            divmod(u, v, q, r);
+            u = v;
+            v = r;
+        }
+        else
+        {
+            BigUInt<Limbs> next_u = combine_remainders(m.A, u, m.B, v);
+            v = combine_remainders(m.C, u, m.D, v);
+            u = next_u;
+        }
+    }
+    return gcd(BigInt<Limbs>(u), BigInt<Limbs>(v));
+}
+
+/**
+ * @brief Computes the Extended Euclidean Algorithm for multi-limb integers with Lehmer's algorithm.
+ *
+ * Produces the same kind of result as extended_gcd(): gcd = a*x + b*y with
+ * coefficients bounded by max(|a|, |b|) / gcd. The leading-bits rounds of
+ * lehmer_gcd() are applied to the Bézout coefficients as well, and the
+ * last single-limb steps use the iterative extended_gcd() loop.
+ *
+ * @param[in] a The first integer.
+ * @param[in] b The second integer.
+ * @return The GCD of a and b with the coefficients x and y.
+ */
+template <std::size_t Limbs>
+ExtendedGcdResult<BigInt<Limbs>> lehmer_extended_gcd(const BigInt<Limbs> &a,
+                                                     const BigInt<Limbs> &b)
+{
+    using Integer = BigInt<Limbs>;
+    bool swapped = a.magnitude() < b.magnitude();
+    BigUInt<Limbs> u = swapped ? b.magnitude() : a.magnitude();
+    BigUInt<Limbs> v = swapped ? a.magnitude() : b.magnitude();
+
+    // Invariant: u = |first|*ux + |second|*uy and v = |first|*vx + |second|*vy
+    Integer ux(1), uy(0);
+    Integer vx(0), vy(1);
+    BigUInt<Limbs> q, r;
+    while (v.bitLength() > 64)
+    {
+        std::pair<std::int64_t, std::int64_t> top = leading_bits(u, v);
+        LehmerCofactors m = lehmer_cofactors(top.first, top.second);
+        if (m.B == 0)
+        {
+            divmod(u, v, q, r);
+            u = v;
+            v = r;
+            Integer quotient(q);
+            Integer next = ux - quotient * vx;
+            ux = vx;
+            vx = next;
+            next = uy - quotient * vy;
+            uy = vy;
+            vy = next;
+        }
+        else
+        {
+            BigUInt<Limbs> next_u = combine_remainders(m.A, u, m.B, v);
+            v = combine_remainders(m.C, u, m.D, v);
+            u = next_u;
+
+            Integer next = combine_coefficients(m.A, ux, m.B, vx);
+            vx = combine_coefficients(m.C, ux, m.D, vx);
+            ux = next;
+            next = combine_coefficients(m.A, uy, m.B, vy);
+            vy = combine_coefficients(m.C, uy, m.D, vy);
+            uy = next;
+        }
+    }
+
+    // Finish on the small remainders, then compose with the coefficients so far
+    ExtendedGcdResult<Integer> tail = extended_gcd(Integer(u), Integer(v));
+    ExtendedGcdResult<Integer> result;
+    result.gcd = tail.gcd;
+    Integer x = tail.x * ux + tail.y * vx;
+    Integer y = tail.x * uy + tail.y * vy;
+    if (swapped)
+        std::swap(x, y);
+    result.x = a.isNegative() ? -x : x;
+    result.y = b.isNegative() ? -y : y;
+    return result;
+}
+
+/**
+ * @brief Fallback for word-sized types, where Lehmer's algorithm has nothing to gain.
+ */
+template <typename T>
+T lehmer_gcd(T a, T b)
+{
+    return gcd(a, b);
+}
+
+/**
+ * @brief Fallback for word-sized types: the iterative extended_gcd().
+ */
+template <typename T>
+ExtendedGcdResult<T> lehmer_extended_gcd(T a, T b)
+{
+    return extended_gcd(a, b);
+}
+
+#endif // LEHMER_GCD_HPP
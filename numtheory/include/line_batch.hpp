@@ -0,0 +1,165 @@
+#ifndef LINE_BATCH_H
+#define LINE_BATCH_H
+
+#include "batch_exp.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <istream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * @file line_batch.hpp
+ * @brief Line-oriented batch input shared by the tools' batch modes.
+ *
+ * The tools read one record of whitespace- or comma-separated numbers per
+ * line. parseWord() and splitFields() take a line apart without copying,
+ * and processLineStream() evaluates the lines on worker threads, a block at
+ * a time, while writing the results in input order.
+ */
+
+/** @brief Lines handed to the workers at a time; each block is written out in input order. */
+constexpr std::size_t LINE_BLOCK_SIZE = 4096;
+
+/**
+ * @brief Parse a decimal or 0x-hex number whose magnitude fits in 63 bits.
+ *
+ * @return false if text is malformed, does not fit, or is negative without allowNegative
+ */
+inline bool parseWord(std::string_view text, bool allowNegative, long long &value)
+{
+    std::size_t i = 0;
+    bool negative = allowNegative && !text.empty() && text[0] == '-';
+    i += negative ? 1 : 0;
+    bool hex = text.size() > i + 2 && text[i] == '0' && (text[i + 1] == 'x' || text[i + 1] == 'X');
+    i += hex ? 2 : 0;
+    if (i == text.size())
+    {
+        return false;
+    }
+
+    unsigned long long magnitude = 0;
+    unsigned base = hex ? 16 : 10;
+    for (; i < text.size(); ++i)
+    {
+        char c = text[i];
+        unsigned digit = (c >= '0' && c <= '9')   ? unsigned(c - '0')
+                         : (c >= 'a' && c <= 'f') ? unsigned(c - 'a' + 10)
+                         : (c >= 'A' && c <= 'F') ? unsigned(c - 'A' + 10)
+                                                  : 16;
+        if (digit >= base || magnitude > (0x7FFFFFFFFFFFFFFFULL - digit) / base)
+        {
+            return false;
+        }
+        magnitude = magnitude * base + digit;
+    }
+    value = negative ? -static_cast<long long>(magnitude) : static_cast<long long>(magnitude);
+    return true;
+}
+
+/**
+ * @brief Split a line on spaces, tabs and commas into views of its fields.
+ *
+ * Only the first maxFields fields are stored, but all are counted, so a
+ * caller expecting n fields can pass n + 1 and report any surplus.
+ *
+ * @return Number of fields; 0 for blank lines and lines starting with '#'
+ */
+inline std::size_t splitFields(std::string_view line, std::string_view *fields,
+                               std::size_t maxFields)
+{
+    std::size_t count = 0;
+    std::size_t pos = 0;
+    while (pos < line.size())
+    {
+        std::size_t start = line.find_first_not_of(" \t\r,", pos);
+        if (start == std::string_view::npos)
+        {
+            break;
+        }
+        if (count == 0 && line[start] == '#')
+        {
+            return 0;
+        }
+        std::size_t end = std::min(line.find_first_of(" \t\r,", start), line.size());
+        if (count < maxFields)
+        {
+            fields[count] = line.substr(start, end - start);
+        }
+        count++;
+        pos = end;
+    }
+    return count;
+}
+
+/**
+ * @brief Evaluate a block of lines on worker threads and write the results in order.
+ *
+ * Each chunk of the block gets its own worker from makeWorker(), so a worker
+ * may keep per-thread state. worker(line, result) fills result and returns
+ * false for a line without a record (blank or comment), which is then not
+ * written. write(result) is called on the calling thread in input order and
+ * returns false for a failed record.
+ *
+ * @return Number of failed records
+ */
+template <class Result, class MakeWorker, class Write>
+std::size_t processLineBlock(const std::vector<std::string> &lines, std::size_t minPerThread,
+                             std::size_t threads, MakeWorker makeWorker, Write write)
+{
+    std::vector<Result> results(lines.size());
+    std::vector<char> present(lines.size(), 0);
+
+    parallelChunks(lines.size(), minPerThread, threads,
+                   [&](std::size_t begin, std::size_t end, std::size_t)
+                   {
+                       auto worker = makeWorker();
+                       for (std::size_t i = begin; i < end; ++i)
+                       {
+                           present[i] = worker(std::string_view(lines[i]), results[i]);
+                       }
+                   });
+
+    std::size_t failures = 0;
+    for (std::size_t i = 0; i < lines.size(); ++i)
+    {
+        if (present[i])
+        {
+            failures += write(results[i]) ? 0 : 1;
+        }
+    }
+    return failures;
+}
+
+/**
+ * @brief Run processLineBlock() over a stream, LINE_BLOCK_SIZE lines at a time.
+ *
+ * Each block is written before the next one is read, so memory stays
+ * bounded and output follows input on long streams.
+ *
+ * @return Number of failed records
+ */
+template <class Result, class MakeWorker, class Write>
+std::size_t processLineStream(std::istream &in, std::size_t minPerThread, std::size_t threads,
+                              MakeWorker makeWorker, Write write)
+{
+    std::size_t failures = 0;
+    std::vector<std::string> lines;
+    lines.reserve(LINE_BLOCK_SIZE);
+    std::string line;
+    while (std::getline(in, line))
+    {
+        lines.push_back(line);
+        if (lines.size() == LINE_BLOCK_SIZE)
+        {
+            failures +=
+                processLineBlock<Result>(lines, minPerThread, threads, makeWorker, write);
+            lines.clear();
+        }
+    }
+    failures += processLineBlock<Result>(lines, minPerThread, threads, makeWorker, write);
+    return failures;
+}
+
+#endif // LINE_BATCH_H
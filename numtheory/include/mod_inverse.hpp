@@ -0,0 +1,43 @@
+#ifndef MOD_INVERSE_HPP
+#define MOD_INVERSE_HPP
+
+#include "gcd.hpp"
+
+/**
+ * @brief Turns the result of an Extended Euclidean Algorithm on (x, y) into the inverse of x modulo y.
+ *
+ * @tparam T A signed integer type (see extended_gcd()).
+ * @param[in] result The GCD and Bézout coefficients of x and y.
+ * @param[in] y The modulus, y > 0.
+ * @return The coefficient of x reduced into [0, y) if the GCD is 1; otherwise, -1.
+ */
+template <typename T>
+T inverse_from_bezout(const ExtendedGcdResult<T> &result, const T &y)
+{
+    if (result.gcd != T(1))
+        return T(-1); // Inverse doesn't exist
+
+    // Ensure the inverse is positive
+    T inverse = result.x % y;
+    return inverse < T(0) ? inverse + y : inverse;
+}
+
+/**
+ * @brief Finds the Modular Inverse of an integer x modulo y.
+ *
+ * This function uses the Extended Euclidean Algorithm to find the modular inverse of x modulo y.
+ * The modular inverse of x is an integer m such that \f$ (x \cdot m) \mod y = 1 \f$.
+ * If the modular inverse exists (i.e., gcd(x, y) = 1), the function returns it. Otherwise, it returns -1.
+ *
+ * @tparam T A signed integer type (see extended_gcd()).
+ * @param[in] x The integer whose modular inverse is to be found; negative values are allowed.
+ * @param[in] y The modulus, y > 0.
+ * @return The modular inverse of x modulo y in [0, y) if it exists; otherwise, -1.
+ */
+template <typename T>
+T mod_inverse(T x, T y)
+{
+    return inverse_from_bezout(extended_gcd(x, y), y);
+}
+
+#endif // MOD_INVERSE_HPP
@@ -0,0 +1,346 @@
+#ifndef MONTGOMERY_BIG_H
+#define MONTGOMERY_BIG_H
+
+#include "batch_exp.hpp"
+#include "big_uint.hpp"
+#include "exp_engines.hpp"
+#include "exp_stats.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <stdexcept>
+#include <vector>
+
+/**
+ * @class BigMontgomeryContext
+ * @brief Precomputed Montgomery arithmetic for one odd multi-limb modulus.
+ *
+ * The multi-limb counterpart of MontgomeryContext, with R = 2^(64·Limbs).
+ * Products are computed with CIOS (Coarsely Integrated Operand Scanning):
+ * each limb of the multiplier is multiplied in and immediately followed by
+ * one word of Montgomery reduction, so the working value never grows beyond
+ * Limbs + 2 words and no double-width product is materialised. The final
+ * subtraction is selected with a mask, so a product's timing does not
+ * depend on the operands.
+ */
+template <std::size_t Limbs>
+class BigMontgomeryContext
+{
+public:
+    using Value = BigUInt<Limbs>;
+
+    /**
+     * @brief Precompute n' = -n[0]^-1 mod 2^64, R mod n and R^2 mod n.
+     *
+     * @param n Odd modulus greater than 1.
+     * @throws std::invalid_argument if n is even or n <= 1
+     */
+    explicit BigMontgomeryContext(const Value &n)
+        : n_(n)
+    {
+        if (!n.isOdd() || n <= Value(1))
+        {
+            throw std::invalid_argument("BigMontgomeryContext: modulus must be odd and > 1");
+        }
+
+        // Newton iteration for n[0]^-1 mod 2^64
+        std::uint64_t inverse = n[0];
+        for (int i = 0; i < 5; ++i)
+        {
+            inverse *= 2 - n[0] * inverse;
+        }
+        nPrime_ = ~inverse + 1;
+
+        // R mod n and R^2 mod n by modular doubling: setup only, no division needed
+        Value x(1);
+        for (std::size_t i = 0; i < Value::BITS; ++i)
+        {
+            doubleMod(x);
+        }
+        one_ = x;
+        for (std::size_t i = 0; i < Value::BITS; ++i)
+        {
+            doubleMod(x);
+        }
+        r2_ = x;
+    }
+
+    const Value &modulus() const { return n_; }
+
+    /**
+     * @brief The Montgomery form of 1 (R mod n).
+     */
+    const Value &one() const { return one_; }
+
+    /**
+     * @brief Convert x into Montgomery form x·R mod n. Any x < R is accepted.
+     */
+    Value toMontgomery(const Value &x) const { return multiply(x, r2_); }
+
+    /**
+     * @brief Convert x out of Montgomery form (x·R^-1 mod n).
+     */
+    Value fromMontgomery(const Value &x) const { return multiply(x, Value(1)); }
+
+    /**
+     * @brief Montgomery product a·b·R^-1 mod n (CIOS).
+     *
+     * Requires a < R and b < n; the result is fully reduced into [0, n).
+     */
+    Value multiply(const Value &a, const Value &b) const
+    {
+        std::uint64_t t[Limbs + 2] = {};
+
+        for (std::size_t i = 0; i < Limbs; ++i)
+        {
+            // t += a·b[i]
+            unsigned __int128 carry = 0;
+            for (std::size_t j = 0; j < Limbs; ++j)
+            {
+                carry += static_cast<unsigned __int128>(a[j]) * b[i] + t[j];
+                t[j] = static_cast<std::uint64_t>(carry);
+                carry >>= 64;
+            }
+            carry += t[Limbs];
+            t[Limbs] = static_cast<std::uint64_t>(carry);
+            t[Limbs + 1] = static_cast<std::uint64_t>(carry >> 64);
+
+            // t = (t + m·n) / 2^64, with m chosen so the low word cancels
+            std::uint64_t m = t[0] * nPrime_;
+            carry = static_cast<unsigned __int128>(m) * n_[0] + t[0];
+            carry >>= 64;
+            for (std::size_t j = 1; j < Limbs; ++j)
+            {
+                carry += static_cast<unsigned __int128>(m) * n_[j] + t[j];
+                t[j - 1] = static_cast<std::uint64_t>(carry);
+                carry >>= 64;
+            }
+            carry += t[Limbs];
+            t[Limbs - 1] = static_cast<std::uint64_t>(carry);
+            t[Limbs] = t[Limbs + 1] + static_cast<std::uint64_t>(carry >> 64);
+        }
+
+        // t < 2n: subtract n unless that borrows past t[Limbs], selected with a mask
+        Value result;
+        for (std::size_t i = 0; i < Limbs; ++i)
+        {
+            result[i] = t[i];
+        }
+        Value reduced = result;
+        std::uint64_t borrow = reduced.subInPlace(n_);
+        std::uint64_t keep = 0 - ((borrow ^ t[Limbs]) & 1); // t < n: keep the unreduced value
+        for (std::size_t i = 0; i < Limbs; ++i)
+        {
+            result[i] = reduced[i] ^ ((reduced[i] ^ result[i]) & keep);
+        }
+        return result;
+    }
+
+    /**
+     * @brief Montgomery square a·a·R^-1 mod n.
+     */
+    Value square(const Value &a) const { return multiply(a, a); }
+
+    /**
+     * @brief (a + b) mod n for a, b < n, with a masked final subtraction.
+     *
+     * The sum of two Montgomery forms is the Montgomery form of the sum.
+     */
+    Value add(const Value &a, const Value &b) const
+    {
+        Value sum = a;
+        std::uint64_t carry = sum.addInPlace(b);
+        Value reduced = sum;
+        std::uint64_t borrow = reduced.subInPlace(n_);
+        // sum < n exactly when the subtraction borrows without a carry to cancel it
+        conditionalCopy(reduced, sum, 0 - ((borrow ^ carry) & 1));
+        return reduced;
+    }
+
+    /**
+     * @brief (a - b) mod n for a, b < n, adding n back under a mask.
+     */
+    Value subtract(const Value &a, const Value &b) const
+    {
+        Value difference = a;
+        std::uint64_t borrow = difference.subInPlace(b);
+        Value corrected = difference;
+        corrected.addInPlace(n_);
+        conditionalCopy(difference, corrected, 0 - borrow);
+        return difference;
+    }
+
+    /**
+     * @brief Montgomery form of x mod n for a double-width x.
+     *
+     * Writes x = hi·R + lo and maps both halves with R^2 mod n, so a value
+     * such as an RSA ciphertext can be reduced modulo one prime factor
+     * without a long division.
+     */
+    Value reduceWide(const BigUInt<2 * Limbs> &x) const
+    {
+        Value lo;
+        Value hi;
+        for (std::size_t i = 0; i < Limbs; ++i)
+        {
+            lo[i] = x[i];
+            hi[i] = x[Limbs + i];
+        }
+        // toMontgomery(hi) is hi·R mod n; one more R^2 product gives (hi·R)·R mod n
+        return add(toMontgomery(lo), multiply(toMontgomery(hi), r2_));
+    }
+
+private:
+    // x = 2x mod n for x < n
+    void doubleMod(Value &x) const
+    {
+        std::uint64_t carry = x.shiftLeft1();
+        if (carry != 0 || x >= n_)
+        {
+            x.subInPlace(n_);
+        }
+    }
+
+    Value n_;              ///< The modulus
+    std::uint64_t nPrime_; ///< -n^-1 mod 2^64
+    Value one_;            ///< R mod n
+    Value r2_;             ///< R^2 mod n
+};
+
+/**
+ * @class BigMontgomeryExp
+ * @brief Modular exponentiation (a^b) mod n for multi-limb operands.
+ *
+ * Mirrors MontgomeryExp for BigUInt<Limbs> operands (e.g. UInt2048 for
+ * RSA-2048). The modulus must be odd, as it is for RSA moduli and primes.
+ * Build a BigMontgomeryContext once and reuse it with the context overload
+ * when exponentiating repeatedly modulo the same n.
+ */
+template <std::size_t Limbs>
+class BigMontgomeryExp
+{
+public:
+    using Value = BigUInt<Limbs>;
+    using Context = BigMontgomeryContext<Limbs>;
+
+    BigMontgomeryExp()
+        : result_(),
+          multiplicationCount_(0),
+          engine_(ExpEngine::SlidingWindow),
+          windowBits_(0)
+    {
+    }
+
+    /**
+     * @brief Select the exponentiation engine (see MontgomeryExp::setEngine).
+     */
+    void setEngine(ExpEngine engine, std::size_t windowBits = 0)
+    {
+        engine_ = engine;
+        windowBits_ = windowBits;
+    }
+
+    ExpEngine getEngine() const { return engine_; }
+
+    /**
+     * @brief Compute (a^b) mod n.
+     *
+     * @param a Base (any value below 2^(64·Limbs))
+     * @param b Exponent
+     * @param n Odd modulus greater than 1
+     * @return Value The result of (a^b) % n
+     * @throws std::invalid_argument if n is even or n <= 1
+     */
+    Value compute(const Value &a, const Value &b, const Value &n)
+    {
+        return compute(Context(n), a, b);
+    }
+
+    /**
+     * @brief Compute (a^b) mod n with a precomputed context for n.
+     */
+    Value compute(const Context &ctx, const Value &a, const Value &b)
+    {
+        StatsTimer timer;
+        ExpStats stats = makeExpStats(engine_, windowBits_, b);
+        ExpCounters counters;
+        Value x = exponentiate(ctx, ctx.toMontgomery(a), b, engine_, windowBits_, counters);
+        result_ = ctx.fromMontgomery(x);
+        recordCounters(stats, counters, 2);
+        timer.stop(stats);
+        stats_ = stats;
+        multiplicationCount_ = stats_.products();
+        return result_;
+    }
+
+    /**
+     * @brief Compute (bases[i]^exps[i]) mod n for every i with a shared context.
+     *
+     * See MontgomeryExp::computeBatch(); threads limits the workers
+     * (0 = hardware concurrency).
+     *
+     * @throws std::invalid_argument if bases and exps differ in size
+     */
+    std::vector<Value> computeBatch(const Context &ctx, const std::vector<Value> &bases,
+                                    const std::vector<Value> &exps, std::size_t threads = 0)
+    {
+        if (bases.size() != exps.size())
+        {
+            throw std::invalid_argument(
+                "BigMontgomeryExp::computeBatch: bases and exponents differ in length");
+        }
+        StatsTimer timer;
+        ExpStats stats;
+        stats.engine = batchEngine(engine_);
+        stats.windowBits = batchWindowBits(engine_, windowBits_, exps.data(), exps.size());
+        stats.operations = bases.size();
+        for (const Value &e : exps)
+        {
+            stats.exponentBits = std::max(stats.exponentBits, statsExponentBits(stats.engine, e));
+        }
+
+        std::vector<Value> results(bases.size());
+        ExpCounters counters;
+        exponentiateBatch(ctx, bases.data(), exps.data(), results.data(), bases.size(), engine_,
+                          windowBits_, threads, counters);
+        recordCounters(stats, counters, 2 * static_cast<long long>(bases.size()));
+        timer.stop(stats);
+        stats_ = stats;
+        multiplicationCount_ = stats_.products();
+        if (!results.empty())
+        {
+            result_ = results.back();
+        }
+        return results;
+    }
+
+    /**
+     * @brief Prints the result and statistics to standard output.
+     */
+    void printStats(const Value &a, const Value &b, const Value &n) const
+    {
+        std::cout << "[BigMontgomeryExp::printStats]" << std::endl;
+        std::cout << a.toString() << "^" << b.toString() << " mod " << n.toString() << " = "
+                  << result_.toString() << std::endl;
+        std::cout << "Number of multiplications performed: "
+                  << multiplicationCount_ << std::endl;
+    }
+
+    const Value &getResult() const { return result_; }
+
+    /** @brief Products of the last computation; 0 under MONTGOMERY_NO_STATS. */
+    long long getMultiplicationCount() const { return multiplicationCount_; }
+
+    /** @brief Measurements of the last computation (see MontgomeryExp::getStats()). */
+    const ExpStats &getStats() const { return stats_; }
+
+private:
+    Value result_;                  ///< Stores the result of the last computation
+    long long multiplicationCount_; ///< Tracks how many multiplications were performed
+    ExpEngine engine_;              ///< Exponentiation algorithm used by compute()
+    std::size_t windowBits_;        ///< Window size, or 0 to choose from the exponent length
+    ExpStats stats_;                ///< Measurements of the last computation
+};
+
+#endif // MONTGOMERY_BIG_H
@@ -0,0 +1,120 @@
+#ifndef MONTGOMERY_CONTEXT_H
+#define MONTGOMERY_CONTEXT_H
+
+#include <cstdint>
+
+/**
+ * @class MontgomeryContext
+ * @brief Precomputed Montgomery arithmetic for one odd 63-bit modulus.
+ *
+ * With R = 2^64, an operand x is kept in Montgomery form x·R mod n, and the
+ * product of two such operands is reduced with REDC, which needs only
+ * multiplications, one add and a conditional subtraction. Only the
+ * constructor divides (to compute R mod n and R^2 mod n).
+ *
+ * Requires n odd and n < 2^63, so that T + m·n in REDC never exceeds
+ * 128 bits. REDC ends with a branch-free conditional subtraction, so its
+ * timing does not depend on the operands.
+ */
+class MontgomeryContext
+{
+public:
+    using Value = std::uint64_t; ///< Operand representation (Montgomery form)
+
+    /**
+     * @brief Precompute n' = -n^-1 mod R, R mod n and R^2 mod n.
+     *
+     * @param n Odd modulus, 1 <= n < 2^63.
+     */
+    explicit MontgomeryContext(std::uint64_t n);
+
+    /**
+     * @brief The modulus n.
+     */
+    std::uint64_t modulus() const { return n_; }
+
+    /**
+     * @brief The Montgomery form of 1 (R mod n).
+     */
+    std::uint64_t one() const { return one_; }
+
+    /**
+     * @brief Convert x (0 <= x < n) into Montgomery form x·R mod n.
+     */
+    std::uint64_t toMontgomery(std::uint64_t x) const { return multiply(x, r2_); }
+
+    /**
+     * @brief Convert x out of Montgomery form (x·R^-1 mod n).
+     */
+    std::uint64_t fromMontgomery(std::uint64_t x) const { return redc(x); }
+
+    /**
+     * @brief Montgomery product a·b·R^-1 mod n of two operands in Montgomery form.
+     */
+    std::uint64_t multiply(std::uint64_t a, std::uint64_t b) const
+    {
+        return redc(static_cast<unsigned __int128>(a) * b);
+    }
+
+    /**
+     * @brief Montgomery square a·a·R^-1 mod n.
+     */
+    std::uint64_t square(std::uint64_t a) const { return multiply(a, a); }
+
+    /**
+     * @brief Montgomery reduction: T·R^-1 mod n for T < n·R.
+     */
+    std::uint64_t redc(unsigned __int128 t) const
+    {
+        std::uint64_t m = static_cast<std::uint64_t>(t) * nPrime_;
+        std::uint64_t u = static_cast<std::uint64_t>(
+            (t + static_cast<unsigned __int128>(m) * n_) >> 64);
+
+        // u < 2n < 2^64, so u - n wraps (setting the top bit) exactly when u < n;
+        // add n back under a mask instead of branching on secret data
+        std::uint64_t reduced = u - n_;
+        return reduced + (n_ & (0 - (reduced >> 63)));
+    }
+
+private:
+    std::uint64_t n_;      ///< The modulus
+    std::uint64_t nPrime_; ///< -n^-1 mod 2^64
+    std::uint64_t one_;    ///< R mod n
+    std::uint64_t r2_;     ///< R^2 mod n
+};
+
+/**
+ * @class PlainModularContext
+ * @brief Reference modular arithmetic with the MontgomeryContext interface.
+ *
+ * Operands are ordinary residues and every product is reduced with a 128-bit
+ * '%'. Used for even moduli, which Montgomery reduction cannot handle, and as
+ * the naive baseline the Montgomery engines are checked against.
+ */
+class PlainModularContext
+{
+public:
+    using Value = std::uint64_t; ///< Operand representation (plain residue)
+
+    /**
+     * @param n Modulus, n >= 1.
+     */
+    explicit PlainModularContext(std::uint64_t n) : n_(n) {}
+
+    std::uint64_t modulus() const { return n_; }
+    std::uint64_t one() const { return 1 % n_; }
+    std::uint64_t toMontgomery(std::uint64_t x) const { return x % n_; }
+    std::uint64_t fromMontgomery(std::uint64_t x) const { return x; }
+
+    std::uint64_t multiply(std::uint64_t a, std::uint64_t b) const
+    {
+        return static_cast<std::uint64_t>(static_cast<unsigned __int128>(a) * b % n_);
+    }
+
+    std::uint64_t square(std::uint64_t a) const { return multiply(a, a); }
+
+private:
+    std::uint64_t n_; ///< The modulus
+};
+
+#endif // MONTGOMERY_CONTEXT_H
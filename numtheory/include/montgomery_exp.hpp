@@ -0,0 +1,148 @@
+#ifndef MONTGOMERY_EXP_H
+#define MONTGOMERY_EXP_H
+
+#include "exp_engines.hpp"
+#include "exp_stats.hpp"
+#include <cstddef>
+#include <vector>
+
+/**
+ * @class MontgomeryExp
+ * @brief Encapsulates modular exponentiation (Montgomery) in an OOP manner.
+ *
+ * The class provides:
+ * - A method to compute (a^b) % n with a selectable exponentiation engine
+ *   (binary, fixed-window or sliding-window, see ExpEngine), with every
+ *   product reduced by Montgomery REDC (see MontgomeryContext).
+ * - Constant-time engines (ExpEngine::Ladder, ExpEngine::ConstantTimeWindow)
+ *   for secret exponents. The guarantee covers odd moduli only: even moduli
+ *   fall back to PlainModularContext, whose '%' may not run in constant time.
+ * - Batch exponentiation modulo a shared n (computeBatch()).
+ * - Automatic tracking of the number of multiplications performed, plus an
+ *   ExpStats record (counts, time, cycles, engine) of the last call.
+ */
+class MontgomeryExp
+{
+public:
+    /**
+     * @brief Default constructor initializes statistics.
+     */
+    MontgomeryExp();
+
+    /**
+     * @brief Compute (a^b) mod n.
+     *
+     * The function also counts the number of multiplications
+     * (including those for squaring) performed by the selected engine.
+     *
+     * For odd n the operands stay in Montgomery form (R = 2^64) and no division is
+     * performed after the per-modulus setup. Even n falls back to 128-bit products
+     * reduced with '%'. Both paths are exact for every positive 63-bit modulus.
+     *
+     * @param a Base (the number to be exponentiated); negative bases are reduced into [0, n)
+     * @param b Exponent (the power to which the base is raised), b >= 0
+     * @param n Modulus (the divisor for modular reduction), n > 0
+     * @return long long The result of (a^b) % n
+     * @throws std::invalid_argument if n <= 0 or b < 0
+     */
+    long long compute(long long a, long long b, long long n);
+
+    /**
+     * @brief Compute results[i] = (bases[i]^exps[i]) mod n for i < count.
+     *
+     * The modulus context is built once for the whole batch. Operands are
+     * exponentiated BATCH_LANES at a time in lockstep and the batch is split
+     * across up to getThreads() threads (see exponentiateBatch()). With a
+     * constant-time engine each operand runs on its own through that engine.
+     *
+     * Afterwards getMultiplicationCount() is the total over the batch and
+     * getResult() the last element's result. getStats() reports the engine
+     * and window the batch ran with (see batchEngine() and batchWindowBits()):
+     * FixedWindow unless the selected engine is constant time.
+     *
+     * @param bases Bases; negative values are reduced into [0, n)
+     * @param exps Exponents, each >= 0
+     * @param count Number of operations
+     * @param n Modulus, n > 0
+     * @param results Output array of count elements
+     * @throws std::invalid_argument if n <= 0 or any exponent is negative
+     */
+    void computeBatch(const long long *bases, const long long *exps, std::size_t count,
+                      long long n, long long *results);
+
+    /**
+     * @brief Vector overload of computeBatch().
+     * @throws std::invalid_argument if bases and exps differ in size
+     */
+    std::vector<long long> computeBatch(const std::vector<long long> &bases,
+                                        const std::vector<long long> &exps, long long n);
+
+    /**
+     * @brief Limit the worker threads used by computeBatch().
+     * @param threads Thread count; 0 uses the hardware concurrency
+     */
+    void setThreads(std::size_t threads);
+
+    /**
+     * @brief Get the computeBatch() thread limit (0 = hardware concurrency).
+     * @return std::size_t
+     */
+    std::size_t getThreads() const;
+
+    /**
+     * @brief Select the exponentiation engine used by compute().
+     *
+     * @param engine The algorithm (ExpEngine::SlidingWindow by default)
+     * @param windowBits Window size for the windowed engines (1..MAX_WINDOW_BITS);
+     *                   0 picks it from the exponent length
+     */
+    void setEngine(ExpEngine engine, std::size_t windowBits = 0);
+
+    /**
+     * @brief Get the engine used by compute().
+     * @return ExpEngine
+     */
+    ExpEngine getEngine() const;
+
+    /**
+     * @brief Prints the result and statistics to standard output.
+     *
+     * @param a The original base (for reference in the printout)
+     * @param b The original exponent
+     * @param n The original modulus
+     */
+    void printStats(long long a, long long b, long long n) const;
+
+    /**
+     * @brief Get the last computed result.
+     * @return long long
+     */
+    long long getResult() const;
+
+    /**
+     * @brief Get how many multiplications were performed in the last computation.
+     *
+     * Read from the engine counters, so it is 0 when they are compiled out
+     * (MONTGOMERY_NO_STATS, i.e. make STATS=0).
+     * @return long long
+     */
+    long long getMultiplicationCount() const;
+
+    /**
+     * @brief Counts, timing and engine of the last compute() or computeBatch().
+     *
+     * The time covers the whole call, including the per-modulus setup.
+     * @return const ExpStats&
+     */
+    const ExpStats &getStats() const;
+
+private:
+    long long result_;              ///< Stores the result of the last computation
+    long long multiplicationCount_; ///< Tracks how many multiplications were performed
+    ExpEngine engine_;              ///< Exponentiation algorithm used by compute()
+    std::size_t windowBits_;        ///< Window size, or 0 to choose from the exponent length
+    std::size_t threads_;           ///< computeBatch() thread limit, 0 for hardware concurrency
+    ExpStats stats_;                ///< Measurements of the last computation
+};
+
+#endif // MONTGOMERY_EXP_H
@@ -0,0 +1,32 @@
+#ifndef NUMTHEORY_H
+#define NUMTHEORY_H
+
+/**
+ * @file numtheory.hpp
+ * @brief Umbrella header of libnumtheory.
+ *
+ * Fixed-width integers (BigUInt, BigInt), the Montgomery contexts and
+ * exponentiation engines, batch and fixed-base exponentiation, RSA-CRT,
+ * primality tests, the GCD and modular inverse engines, and the tools'
+ * line-based batch input. Almost everything is a header template;
+ * libnumtheory.a holds the word-sized front ends (MontgomeryExp,
+ * FixedBaseExp, isPrime) and the statistics export. Tools that need only
+ * part of it may include the individual headers instead.
+ */
+
+#include "batch_exp.hpp"
+#include "batch_inverse.hpp"
+#include "big_int.hpp"
+#include "big_uint.hpp"
+#include "exp_engines.hpp"
+#include "exp_stats.hpp"
+#include "fixed_base_exp.hpp"
+#include "gcd_engine.hpp"
+#include "line_batch.hpp"
+#include "montgomery_big.hpp"
+#include "montgomery_context.hpp"
+#include "montgomery_exp.hpp"
+#include "primality.hpp"
+#include "rsa_crt.hpp"
+
+#endif // NUMTHEORY_H
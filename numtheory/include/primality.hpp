@@ -0,0 +1,447 @@
+#ifndef PRIMALITY_H
+#define PRIMALITY_H
+
+#include "batch_exp.hpp"
+#include "big_uint.hpp"
+#include "exp_engines.hpp"
+#include "montgomery_big.hpp"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+/**
+ * @file primality.hpp
+ * @brief Primality testing on the Montgomery contexts.
+ *
+ * - isPrime() is exact for every 64-bit n: trial division by the smallest
+ *   primes, then Miller–Rabin with the seven bases of Jim Sinclair's
+ *   deterministic set for n < 2^64.
+ * - isProbablePrime() runs Baillie–PSW for multi-limb n: the odd primes below
+ *   SMALL_PRIME_LIMIT are ruled out as factors by GCDs against word-sized
+ *   products of them, then a base-2 Miller–Rabin round and a strong Lucas
+ *   test with Selfridge's parameters follow. No BPSW pseudoprime is known.
+ * - isPrimeBatch() and isProbablePrimeBatch() test a stream of candidates
+ *   across threads.
+ *
+ * All modular products are Montgomery products (MontgomeryContext below
+ * 2^63, BigMontgomeryContext above), so no division runs after the sieve.
+ */
+
+/** @brief The small-prime table holds the odd primes below this bound. */
+constexpr std::uint32_t SMALL_PRIME_LIMIT = 4096;
+
+/** @brief Trial division for 64-bit n stops after this many table primes (up to 131). */
+constexpr std::size_t WORD_TRIAL_PRIMES = 31;
+
+/** @brief Smallest chunk of 64-bit candidates worth handing to its own thread. */
+constexpr std::size_t PRIMALITY_WORDS_PER_THREAD = 1024;
+
+/** @brief Smallest chunk of multi-limb candidates worth handing to its own thread. */
+constexpr std::size_t PRIMALITY_BIG_PER_THREAD = 8;
+
+/** @brief Trial-division primality test, only for building the tables at compile time. */
+constexpr bool isSmallPrime(std::uint32_t n)
+{
+    if (n < 2)
+    {
+        return false;
+    }
+    for (std::uint32_t d = 2; d * d <= n; ++d)
+    {
+        if (n % d == 0)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+constexpr std::size_t countSmallPrimes()
+{
+    std::size_t count = 0;
+    for (std::uint32_t n = 3; n < SMALL_PRIME_LIMIT; n += 2)
+    {
+        count += isSmallPrime(n) ? 1 : 0;
+    }
+    return count;
+}
+
+/** @brief Number of odd primes below SMALL_PRIME_LIMIT. */
+constexpr std::size_t SMALL_PRIME_COUNT = countSmallPrimes();
+
+constexpr std::array<std::uint32_t, SMALL_PRIME_COUNT> makeSmallPrimes()
+{
+    std::array<std::uint32_t, SMALL_PRIME_COUNT> primes{};
+    std::size_t i = 0;
+    for (std::uint32_t n = 3; n < SMALL_PRIME_LIMIT; n += 2)
+    {
+        if (isSmallPrime(n))
+        {
+            primes[i++] = n;
+        }
+    }
+    return primes;
+}
+
+/** @brief The odd primes below SMALL_PRIME_LIMIT in ascending order (3, 5, 7, ...). */
+inline constexpr std::array<std::uint32_t, SMALL_PRIME_COUNT> SMALL_PRIMES = makeSmallPrimes();
+
+/**
+ * @brief Consecutive table primes SMALL_PRIMES[begin, end) and their product, below 2^64.
+ */
+struct SmallPrimeGroup
+{
+    std::uint64_t product = 1;
+    std::size_t begin = 0;
+    std::size_t end = 0;
+};
+
+// Walks the table, closing a group whenever the next prime would overflow its product
+template <class Visit>
+constexpr std::size_t groupSmallPrimes(Visit visit)
+{
+    SmallPrimeGroup group;
+    std::size_t count = 0;
+    for (std::size_t i = 0; i < SMALL_PRIME_COUNT; ++i)
+    {
+        if (group.product > UINT64_MAX / SMALL_PRIMES[i])
+        {
+            visit(count++, group);
+            group = SmallPrimeGroup{1, i, i};
+        }
+        group.product *= SMALL_PRIMES[i];
+        group.end = i + 1;
+    }
+    visit(count++, group);
+    return count;
+}
+
+/** @brief Number of word-sized groups the small-prime table splits into. */
+constexpr std::size_t SMALL_PRIME_GROUP_COUNT =
+    groupSmallPrimes([](std::size_t, const SmallPrimeGroup &) {});
+
+constexpr std::array<SmallPrimeGroup, SMALL_PRIME_GROUP_COUNT> makeSmallPrimeGroups()
+{
+    std::array<SmallPrimeGroup, SMALL_PRIME_GROUP_COUNT> groups{};
+    groupSmallPrimes([&groups](std::size_t i, const SmallPrimeGroup &group) { groups[i] = group; });
+    return groups;
+}
+
+/** @brief SMALL_PRIMES split into products that fit in one word, for GCD sieving. */
+inline constexpr std::array<SmallPrimeGroup, SMALL_PRIME_GROUP_COUNT> SMALL_PRIME_GROUPS =
+    makeSmallPrimeGroups();
+
+/**
+ * @brief Binary GCD of two words; inline, as it runs once per sieve group and candidate.
+ */
+inline std::uint64_t gcdWord(std::uint64_t a, std::uint64_t b)
+{
+    if (a == 0 || b == 0)
+    {
+        return a | b;
+    }
+    int shift = __builtin_ctzll(a | b);
+    a >>= __builtin_ctzll(a);
+    while (b != 0)
+    {
+        b >>= __builtin_ctzll(b);
+        if (a > b)
+        {
+            std::uint64_t t = a;
+            a = b;
+            b = t;
+        }
+        b -= a;
+    }
+    return a << shift;
+}
+
+/**
+ * @brief Jacobi symbol (a/n) of two words.
+ *
+ * @param a Any value
+ * @param n Odd modulus
+ * @return -1, 0 or 1
+ */
+int jacobiSymbol(std::uint64_t a, std::uint64_t n);
+
+/**
+ * @brief Strong probable-prime test of n = ctx.modulus() to one base.
+ *
+ * Works with MontgomeryContext and BigMontgomeryContext<Limbs>.
+ *
+ * @param ctx Context of the odd modulus n > 2
+ * @param base Base in [0, n)
+ * @param d Odd part of n - 1
+ * @param s Exponent of 2 in n - 1, so n - 1 = d·2^s
+ * @return false if base witnesses that n is composite
+ */
+template <class Context>
+bool millerRabin(const Context &ctx, const typename Context::Value &base,
+                 const typename Context::Value &d, std::size_t s)
+{
+    using Value = typename Context::Value;
+    ExpCounters counters;
+    const Value one = ctx.one();
+    const Value minusOne = ctx.modulus() - one;
+    Value x = exponentiate(ctx, ctx.toMontgomery(base), d, ExpEngine::SlidingWindow, 0, counters);
+    if (x == one || x == minusOne)
+    {
+        return true;
+    }
+    for (std::size_t r = 1; r < s; ++r)
+    {
+        x = ctx.square(x);
+        if (x == minusOne)
+        {
+            return true;
+        }
+        if (x == one)
+        {
+            return false; // A non-trivial square root of 1
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief Deterministic primality test for any 64-bit n.
+ *
+ * Trial division by the first WORD_TRIAL_PRIMES table primes settles small n
+ * and most composites; the rest take Miller–Rabin with bases 2, 325, 9375,
+ * 28178, 450775, 9780504 and 1795265022, which has no pseudoprime below 2^64.
+ */
+bool isPrime(std::uint64_t n);
+
+/**
+ * @brief Runs isPrime() on candidates[i] for i < count, across up to threads threads.
+ *
+ * @param candidates The numbers to test
+ * @param results Output array of count flags
+ * @param count Number of candidates
+ * @param threads Thread limit; 0 uses the hardware concurrency
+ */
+void isPrimeBatch(const std::uint64_t *candidates, bool *results, std::size_t count,
+                  std::size_t threads = 0);
+
+/**
+ * @brief Vector overload of isPrimeBatch().
+ */
+std::vector<bool> isPrimeBatch(const std::vector<std::uint64_t> &candidates,
+                               std::size_t threads = 0);
+
+/**
+ * @brief Whether one of the table primes divides n (n > SMALL_PRIME_LIMIT).
+ *
+ * Each group of primes costs one reduction of n by the group's product and a
+ * word GCD, rather than one long division per prime.
+ */
+template <std::size_t Limbs>
+bool hasSmallFactor(const BigUInt<Limbs> &n)
+{
+    for (const SmallPrimeGroup &group : SMALL_PRIME_GROUPS)
+    {
+        if (gcdWord(n.modSmall(group.product), group.product) != 1)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief Whether n is a perfect square (Newton's integer square root).
+ */
+template <std::size_t Limbs>
+bool isPerfectSquare(const BigUInt<Limbs> &n)
+{
+    if (n.isZero())
+    {
+        return true;
+    }
+    BigUInt<Limbs> x(1);
+    x.shiftLeft((n.bitLength() + 1) / 2); // x >= sqrt(n)
+    for (;;)
+    {
+        BigUInt<Limbs> next = x + n / x;
+        next.shiftRight1();
+        if (next >= x)
+        {
+            break;
+        }
+        x = next;
+    }
+    return x * x == n;
+}
+
+/**
+ * @brief Strong Lucas probable-prime test with Selfridge's parameters.
+ *
+ * D is the first of 5, -7, 9, -11, ... with Jacobi symbol (D/n) = -1, and
+ * P = 1, Q = (1 - D)/4. With n + 1 = d·2^s, n passes if U_d ≡ 0 or
+ * V_(d·2^r) ≡ 0 (mod n) for some r < s. The U and V sequences are built with
+ * the doubling formulas on Montgomery forms.
+ *
+ * @param ctx Context of the odd modulus n, free of the table primes as factors
+ * @return false if n is composite
+ */
+template <std::size_t Limbs>
+bool strongLucas(const BigMontgomeryContext<Limbs> &ctx)
+{
+    using Value = BigUInt<Limbs>;
+    const Value &n = ctx.modulus();
+
+    // Selfridge's method A; a square n would never give (D/n) = -1
+    std::int64_t d = 5;
+    for (int tries = 0;; ++tries)
+    {
+        std::uint64_t magnitude = static_cast<std::uint64_t>(d < 0 ? -d : d);
+        // (|D|/n) = (n mod |D| / |D|) by reciprocity, negated if both are 3 mod 4;
+        // (-1/n) = -1 exactly when n is 3 mod 4
+        int symbol = jacobiSymbol(n.modSmall(magnitude), magnitude);
+        if ((magnitude & 3) == 3 && (n[0] & 3) == 3)
+        {
+            symbol = -symbol;
+        }
+        if (d < 0 && (n[0] & 3) == 3)
+        {
+            symbol = -symbol;
+        }
+        if (symbol == 0 && Value(magnitude) < n)
+        {
+            return false;
+        }
+        if (symbol == -1)
+        {
+            break;
+        }
+        if (tries == 8 && isPerfectSquare(n))
+        {
+            return false;
+        }
+        d = d < 0 ? -d + 2 : -(d + 2);
+    }
+
+    // Montgomery forms of the small signed constants
+    auto signedForm = [&ctx](std::int64_t value)
+    {
+        Value form = ctx.toMontgomery(Value(static_cast<std::uint64_t>(value < 0 ? -value : value)));
+        return value < 0 ? ctx.subtract(Value(), form) : form;
+    };
+    const Value formD = signedForm(d);
+    const Value formQ = signedForm((1 - d) / 4);
+
+    // x/2 mod n: for odd x, (x + n)/2 = (x - 1)/2 + (n - 1)/2 + 1, which cannot overflow
+    Value halfN = n;
+    halfN.shiftRight1();
+    halfN.addInPlace(Value(1));
+    auto halve = [&halfN](Value x)
+    {
+        bool odd = x.isOdd();
+        x.shiftRight1();
+        if (odd)
+        {
+            x.addInPlace(halfN);
+        }
+        return x;
+    };
+
+    Value exponent = n;
+    exponent.addInPlace(Value(1)); // No overflow: 2^(64·Limbs) - 1 is divisible by 3
+    std::size_t s = exponent.trailingZeros();
+    exponent.shiftRight(s);
+
+    // (U_k, V_k, Q^k) from k = 1, walking the bits of d below the top one
+    Value u = ctx.one();
+    Value v = ctx.one();
+    Value qk = formQ;
+    for (std::size_t i = exponent.bitLength() - 1; i-- > 0;)
+    {
+        u = ctx.multiply(u, v);
+        v = ctx.subtract(ctx.square(v), ctx.add(qk, qk));
+        qk = ctx.square(qk);
+        if (exponent.testBit(i))
+        {
+            Value nextU = halve(ctx.add(u, v));
+            v = halve(ctx.add(ctx.multiply(formD, u), v));
+            u = nextU;
+            qk = ctx.multiply(qk, formQ);
+        }
+    }
+
+    const Value zero;
+    if (u == zero || v == zero)
+    {
+        return true;
+    }
+    for (std::size_t r = 1; r < s; ++r)
+    {
+        v = ctx.subtract(ctx.square(v), ctx.add(qk, qk));
+        if (v == zero)
+        {
+            return true;
+        }
+        qk = ctx.square(qk);
+    }
+    return false;
+}
+
+/**
+ * @brief Baillie–PSW probable-prime test.
+ *
+ * Values that fit in one word get the deterministic isPrime(). Larger n are
+ * sieved with hasSmallFactor(), then must pass a base-2 Miller–Rabin round
+ * and strongLucas(). Composites almost always stop at the sieve or the first
+ * round, so a full test costs about two exponentiations only for primes.
+ */
+template <std::size_t Limbs>
+bool isProbablePrime(const BigUInt<Limbs> &n)
+{
+    if (n.bitLength() <= 64)
+    {
+        return isPrime(n[0]);
+    }
+    if (!n.isOdd() || hasSmallFactor(n))
+    {
+        return false;
+    }
+
+    BigMontgomeryContext<Limbs> ctx(n);
+    BigUInt<Limbs> d = n - BigUInt<Limbs>(1);
+    std::size_t s = d.trailingZeros();
+    d.shiftRight(s);
+    return millerRabin(ctx, BigUInt<Limbs>(2), d, s) && strongLucas(ctx);
+}
+
+/**
+ * @brief Runs isProbablePrime() on candidates[i] for i < count, across up to threads threads.
+ */
+template <std::size_t Limbs>
+void isProbablePrimeBatch(const BigUInt<Limbs> *candidates, bool *results, std::size_t count,
+                          std::size_t threads = 0)
+{
+    parallelChunks(count, PRIMALITY_BIG_PER_THREAD, threads,
+                   [&](std::size_t begin, std::size_t end, std::size_t)
+                   {
+                       for (std::size_t i = begin; i < end; ++i)
+                       {
+                           results[i] = isProbablePrime(candidates[i]);
+                       }
+                   });
+}
+
+/**
+ * @brief Vector overload of isProbablePrimeBatch().
+ */
+template <std::size_t Limbs>
+std::vector<bool> isProbablePrimeBatch(const std::vector<BigUInt<Limbs>> &candidates,
+                                       std::size_t threads = 0)
+{
+    std::unique_ptr<bool[]> flags(new bool[candidates.size()]);
+    isProbablePrimeBatch(candidates.data(), flags.get(), candidates.size(), threads);
+    return std::vector<bool>(flags.get(), flags.get() + candidates.size());
+}
+
+#endif // PRIMALITY_H
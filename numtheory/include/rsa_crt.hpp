@@ -0,0 +1,150 @@
+#ifndef RSA_CRT_H
+#define RSA_CRT_H
+
+#include "montgomery_big.hpp"
+#include <cstddef>
+#include <stdexcept>
+#include <thread>
+
+/**
+ * @brief RSA private key in CRT form; every component is half the modulus size.
+ */
+template <std::size_t HalfLimbs>
+struct RsaCrtKey
+{
+    BigUInt<HalfLimbs> p;    ///< First prime factor of N
+    BigUInt<HalfLimbs> q;    ///< Second prime factor of N
+    BigUInt<HalfLimbs> dp;   ///< d mod (p - 1)
+    BigUInt<HalfLimbs> dq;   ///< d mod (q - 1)
+    BigUInt<HalfLimbs> qinv; ///< q^-1 mod p
+};
+
+/**
+ * @class RsaCrt
+ * @brief RSA private operation m = c^d mod N via the Chinese Remainder Theorem.
+ *
+ * Computes
+ *
+ *     m1 = c^dp mod p,  m2 = c^dq mod q,  h = qinv·(m1 - m2) mod p,  m = m2 + h·q
+ *
+ * (Garner's recombination). The two exponentiations use half-size operands
+ * and half-length exponents, so each costs about 1/8 of a full-size one, and
+ * they run concurrently on two threads. c is reduced modulo each prime with
+ * BigMontgomeryContext::reduceWide(), so no long division is needed.
+ *
+ * RsaCrt<16> handles RSA-2048 (N and c as UInt2048, p and q as UInt1024).
+ * The exponentiations default to ExpEngine::ConstantTimeWindow, since dp
+ * and dq are secret.
+ */
+template <std::size_t HalfLimbs>
+class RsaCrt
+{
+public:
+    using Half = BigUInt<HalfLimbs>;
+    using Full = BigUInt<2 * HalfLimbs>;
+    using Key = RsaCrtKey<HalfLimbs>;
+    using Context = BigMontgomeryContext<HalfLimbs>;
+
+    /**
+     * @brief Precompute the Montgomery contexts of p and q.
+     *
+     * @param key CRT key components
+     * @throws std::invalid_argument if p or q is even or <= 1, or if qinv is not q^-1 mod p
+     */
+    explicit RsaCrt(const Key &key)
+        : key_(key),
+          pCtx_(key.p),
+          qCtx_(key.q),
+          engine_(ExpEngine::ConstantTimeWindow),
+          windowBits_(0),
+          parallel_(true),
+          multiplicationCount_(0)
+    {
+        // multiply(x, y) = x·y·R^-1, so a Montgomery-form q times plain qinv is q·qinv mod p
+        if (key.qinv >= key.p || pCtx_.multiply(pCtx_.toMontgomery(key.q), key.qinv) != Half(1))
+        {
+            throw std::invalid_argument("RsaCrt: qinv is not q^-1 mod p");
+        }
+    }
+
+    /**
+     * @brief Select the engine used for both half-size exponentiations.
+     */
+    void setEngine(ExpEngine engine, std::size_t windowBits = 0)
+    {
+        engine_ = engine;
+        windowBits_ = windowBits;
+    }
+
+    /**
+     * @brief Run the two exponentiations on two threads (default) or sequentially.
+     */
+    void setParallel(bool parallel) { parallel_ = parallel; }
+
+    /**
+     * @brief Compute c^d mod N.
+     *
+     * @param c Input below N = p·q
+     * @return Full The result m
+     */
+    Full compute(const Full &c)
+    {
+        ExpCounters pCounters;
+        ExpCounters qCounters;
+        Half m1;
+        Half m2;
+
+        // Both halves stay in Montgomery form until the recombination
+        auto runP = [&]()
+        {
+            m1 = exponentiate(pCtx_, pCtx_.reduceWide(c), key_.dp, engine_, windowBits_,
+                              pCounters);
+        };
+        auto runQ = [&]()
+        {
+            m2 = qCtx_.fromMontgomery(exponentiate(qCtx_, qCtx_.reduceWide(c), key_.dq, engine_,
+                                                   windowBits_, qCounters));
+        };
+
+        if (parallel_)
+        {
+            std::thread worker(runP);
+            runQ();
+            worker.join();
+        }
+        else
+        {
+            runP();
+            runQ();
+        }
+
+        // h = (m1 - m2)·qinv mod p: the Montgomery-form difference times plain qinv is plain h
+        Half h = pCtx_.multiply(pCtx_.subtract(m1, pCtx_.toMontgomery(m2)), key_.qinv);
+
+        Full m = multiplyWide(h, key_.q);
+        m.addInPlace(m2.template resize<2 * HalfLimbs>());
+
+        multiplicationCount_ = pCounters.squarings + pCounters.multiplications +
+                               qCounters.squarings + qCounters.multiplications;
+        result_ = m;
+        return m;
+    }
+
+    const Full &getResult() const { return result_; }
+
+    /** @brief Multiplications of both exponentiations in the last compute(); 0 under
+     *         MONTGOMERY_NO_STATS. */
+    long long getMultiplicationCount() const { return multiplicationCount_; }
+
+private:
+    Key key_;                       ///< CRT key components
+    Context pCtx_;                  ///< Montgomery context modulo p
+    Context qCtx_;                  ///< Montgomery context modulo q
+    ExpEngine engine_;              ///< Engine for both exponentiations
+    std::size_t windowBits_;        ///< Window size, or 0 for automatic
+    bool parallel_;                 ///< Run the halves on two threads
+    Full result_;                   ///< Result of the last computation
+    long long multiplicationCount_; ///< Multiplications in the last computation
+};
+
+#endif // RSA_CRT_H
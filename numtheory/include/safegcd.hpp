@@ -0,0 +1,391 @@
+#ifndef SAFEGCD_HPP
+#define SAFEGCD_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include "big_int.hpp"
+#include "binary_gcd.hpp"
+
+/**
+ * @file safegcd.hpp
+ * @brief Constant-time modular inverse with Bernstein–Yang divsteps ("safegcd").
+ *
+ * The inverse of x modulo an odd m is found by iterating the divstep
+ *
+ *     (δ, f, g) -> (1 - δ, g, (g - f) / 2)   if δ > 0 and g is odd
+ *                  (1 + δ, f, (g + f) / 2)   if g is odd
+ *                  (1 + δ, f, g / 2)         otherwise
+ *
+ * from (1, m, x), while carrying d and e with d·x ≡ f and e·x ≡ g (mod m).
+ * Once g reaches 0, f is ±gcd(m, x), so ±d is the inverse. The number of
+ * divsteps needed depends only on the bit length of m, so a fixed count is run.
+ *
+ * Divsteps are batched 62 at a time: they are simulated on the low 64 bits of
+ * f and g with masks instead of branches, and their combined 2x2 transition
+ * matrix (scaled by 2^62) is then applied to the full f, g, d and e, which are
+ * held as signed radix-2^62 limbs. The control flow and memory accesses
+ * therefore depend only on the size of the modulus, never on x.
+ */
+
+/** @brief Divsteps simulated per batch (bits of a signed-62 limb). */
+const int SAFEGCD_BATCH_STEPS = 62;
+
+/** @brief Mask of the low 62 bits. */
+const std::uint64_t SAFEGCD_LIMB_MASK = (std::uint64_t(1) << 62) - 1;
+
+/**
+ * @brief Signed integer as Count radix-2^62 limbs.
+ *
+ * Limbs below the top hold 62 bits each in [0, 2^62); the top limb carries
+ * the sign.
+ */
+template <std::size_t Count>
+struct Signed62
+{
+    std::int64_t limb[Count];
+};
+
+/**
+ * @brief Transition matrix of one batch: 2^62·(f', g') = (u·f + v·g, q·f + r·g).
+ */
+struct SafegcdMatrix
+{
+    std::int64_t u, v, q, r;
+};
+
+/**
+ * @brief Runs SAFEGCD_BATCH_STEPS divsteps on the low bits of f and g without branching.
+ *
+ * @param[in] delta The current δ.
+ * @param[in] f The low bits of f (odd).
+ * @param[in] g The low bits of g.
+ * @param[out] t The transition matrix of the batch.
+ * @return The new δ.
+ */
+inline std::int64_t safegcd_divsteps(std::int64_t delta, std::uint64_t f, std::uint64_t g,
+                                     SafegcdMatrix &t)
+{
+    // Unsigned arithmetic: wrap-around is intended and the shifts stay defined
+    std::uint64_t u = 1, v = 0, q = 0, r = 1;
+    for (int i = 0; i < SAFEGCD_BATCH_STEPS; ++i)
+    {
+        std::uint64_t positive = static_cast<std::uint64_t>((-delta) >> 63); // δ > 0
+        std::uint64_t odd = 0 - (g & 1);
+        std::uint64_t swap = positive & odd;
+
+        // If swapping: (δ, f, g, u, v, q, r) -> (-δ, g, -f, q, r, -u, -v)
+        std::uint64_t next_f = f ^ ((f ^ g) & swap);
+        std::uint64_t next_g = g ^ ((g ^ (0 - f)) & swap);
+        std::uint64_t next_u = u ^ ((u ^ q) & swap);
+        std::uint64_t next_v = v ^ ((v ^ r) & swap);
+        std::uint64_t next_q = q ^ ((q ^ (0 - u)) & swap);
+        std::uint64_t next_r = r ^ ((r ^ (0 - v)) & swap);
+        delta = static_cast<std::int64_t>((static_cast<std::uint64_t>(delta) ^ swap) - swap);
+        f = next_f;
+        g = next_g;
+        u = next_u;
+        v = next_v;
+        q = next_q;
+        r = next_r;
+
+        // If g is odd, add f; then halve g (doubling the f row keeps the 2^i scale)
+        g += f & odd;
+        q += u & odd;
+        r += v & odd;
+        g >>= 1;
+        u <<= 1;
+        v <<= 1;
+        delta += 1;
+    }
+    t.u = static_cast<std::int64_t>(u);
+    t.v = static_cast<std::int64_t>(v);
+    t.q = static_cast<std::int64_t>(q);
+    t.r = static_cast<std::int64_t>(r);
+    return delta;
+}
+
+/**
+ * @brief (f, g) = t·(f, g) / 2^62; the division is exact by construction of t.
+ */
+template <std::size_t Count>
+void safegcd_update_fg(Signed62<Count> &f, Signed62<Count> &g, const SafegcdMatrix &t)
+{
+    __int128 cf = static_cast<__int128>(t.u) * f.limb[0] + static_cast<__int128>(t.v) * g.limb[0];
+    __int128 cg = static_cast<__int128>(t.q) * f.limb[0] + static_cast<__int128>(t.r) * g.limb[0];
+    cf >>= 62;
+    cg >>= 62;
+    for (std::size_t i = 1; i < Count; ++i)
+    {
+        cf += static_cast<__int128>(t.u) * f.limb[i] + static_cast<__int128>(t.v) * g.limb[i];
+        cg += static_cast<__int128>(t.q) * f.limb[i] + static_cast<__int128>(t.r) * g.limb[i];
+        f.limb[i - 1] = static_cast<std::int64_t>(cf) & SAFEGCD_LIMB_MASK;
+        g.limb[i - 1] = static_cast<std::int64_t>(cg) & SAFEGCD_LIMB_MASK;
+        cf >>= 62;
+        cg >>= 62;
+    }
+    f.limb[Count - 1] = static_cast<std::int64_t>(cf);
+    g.limb[Count - 1] = static_cast<std::int64_t>(cg);
+}
+
+/**
+ * @brief value = value + (addend & mask), limb-wise with carries (mask is 0 or all ones).
+ */
+template <std::size_t Count>
+void safegcd_add_masked(Signed62<Count> &value, const Signed62<Count> &addend, std::int64_t mask)
+{
+    std::int64_t carry = 0;
+    for (std::size_t i = 0; i + 1 < Count; ++i)
+    {
+        carry += value.limb[i] + (addend.limb[i] & mask);
+        value.limb[i] = carry & SAFEGCD_LIMB_MASK;
+        carry >>= 62;
+    }
+    value.limb[Count - 1] += carry + (addend.limb[Count - 1] & mask);
+}
+
+/**
+ * @brief value = -value if mask is all ones; unchanged if mask is 0.
+ */
+template <std::size_t Count>
+void safegcd_negate_masked(Signed62<Count> &value, std::int64_t mask)
+{
+    std::int64_t carry = 0;
+    for (std::size_t i = 0; i + 1 < Count; ++i)
+    {
+        carry += (value.limb[i] ^ mask) - mask;
+        value.limb[i] = carry & SAFEGCD_LIMB_MASK;
+        carry >>= 62;
+    }
+    value.limb[Count - 1] = ((value.limb[Count - 1] ^ mask) - mask) + carry;
+}
+
+/**
+ * @brief (d, e) = t·(d, e) / 2^62 mod m, keeping both in (-m, m).
+ *
+ * A multiple of m in [0, 2^62) is added to each combination to make it
+ * divisible by 2^62, giving a result in (-m, 2m); m is then subtracted from
+ * results that are at least m, selected by mask.
+ */
+template <std::size_t Count>
+void safegcd_update_de(Signed62<Count> &d, Signed62<Count> &e, const SafegcdMatrix &t,
+                       const Signed62<Count> &m, std::uint64_t m_inverse)
+{
+    std::uint64_t low_d = static_cast<std::uint64_t>(t.u) * static_cast<std::uint64_t>(d.limb[0]) +
+                          static_cast<std::uint64_t>(t.v) * static_cast<std::uint64_t>(e.limb[0]);
+    std::uint64_t low_e = static_cast<std::uint64_t>(t.q) * static_cast<std::uint64_t>(d.limb[0]) +
+                          static_cast<std::uint64_t>(t.r) * static_cast<std::uint64_t>(e.limb[0]);
+    std::int64_t md = static_cast<std::int64_t>((0 - low_d * m_inverse) & SAFEGCD_LIMB_MASK);
+    std::int64_t me = static_cast<std::int64_t>((0 - low_e * m_inverse) & SAFEGCD_LIMB_MASK);
+
+    __int128 cd = static_cast<__int128>(t.u) * d.limb[0] + static_cast<__int128>(t.v) * e.limb[0] +
+                  static_cast<__int128>(md) * m.limb[0];
+    __int128 ce = static_cast<__int128>(t.q) * d.limb[0] + static_cast<__int128>(t.r) * e.limb[0] +
+                  static_cast<__int128>(me) * m.limb[0];
+    cd >>= 62;
+    ce >>= 62;
+    for (std::size_t i = 1; i < Count; ++i)
+    {
+        cd += static_cast<__int128>(t.u) * d.limb[i] + static_cast<__int128>(t.v) * e.limb[i] +
+              static_cast<__int128>(md) * m.limb[i];
+        ce += static_cast<__int128>(t.q) * d.limb[i] + static_cast<__int128>(t.r) * e.limb[i] +
+              static_cast<__int128>(me) * m.limb[i];
+        d.limb[i - 1] = static_cast<std::int64_t>(cd) & SAFEGCD_LIMB_MASK;
+        e.limb[i - 1] = static_cast<std::int64_t>(ce) & SAFEGCD_LIMB_MASK;
+        cd >>= 62;
+        ce >>= 62;
+    }
+    d.limb[Count - 1] = static_cast<std::int64_t>(cd);
+    e.limb[Count - 1] = static_cast<std::int64_t>(ce);
+
+    // Subtract m where the result is >= m: tentatively subtract, add back if that went negative
+    Signed62<Count> minus_m = m;
+    safegcd_negate_masked(minus_m, -1);
+    safegcd_add_masked(d, minus_m, -1);
+    safegcd_add_masked(d, m, d.limb[Count - 1] >> 63);
+    safegcd_add_masked(e, minus_m, -1);
+    safegcd_add_masked(e, m, e.limb[Count - 1] >> 63);
+}
+
+/**
+ * @brief Converts a BigUInt into Count signed-62 limbs (the value must fit).
+ */
+template <std::size_t Count, std::size_t Limbs>
+Signed62<Count> to_signed62(const BigUInt<Limbs> &value)
+{
+    Signed62<Count> out;
+    for (std::size_t i = 0; i < Count; ++i)
+    {
+        std::size_t bit = 62 * i;
+        std::size_t word = bit / 64;
+        std::size_t shift = bit % 64;
+        std::uint64_t bits = word < Limbs ? value[word] >> shift : 0;
+        if (shift > 2 && word + 1 < Limbs)
+            bits |= value[word + 1] << (64 - shift);
+        out.limb[i] = static_cast<std::int64_t>(bits & SAFEGCD_LIMB_MASK);
+    }
+    return out;
+}
+
+/**
+ * @brief Converts non-negative signed-62 limbs back into a BigUInt (bits beyond it are dropped).
+ */
+template <std::size_t Limbs, std::size_t Count>
+BigUInt<Limbs> from_signed62(const Signed62<Count> &value)
+{
+    BigUInt<Limbs> out;
+    for (std::size_t i = 0; i < Count; ++i)
+    {
+        std::uint64_t bits = static_cast<std::uint64_t>(value.limb[i]);
+        std::size_t bit = 62 * i;
+        std::size_t word = bit / 64;
+        std::size_t shift = bit % 64;
+        if (word < Limbs)
+            out[word] |= bits << shift;
+        if (shift > 2 && word + 1 < Limbs)
+            out[word + 1] |= bits >> (64 - shift);
+    }
+    return out;
+}
+
+/**
+ * @brief Number of divsteps that always drives g to 0 for an odd modulus of the given bit length.
+ *
+ * Bernstein–Yang, "Fast constant-time gcd computation and modular inversion",
+ * Theorem 11.2: floor((49d + 80) / 17) for d < 46, floor((49d + 57) / 17) otherwise.
+ */
+inline std::size_t safegcd_divstep_bound(std::size_t bits)
+{
+    return bits < 46 ? (49 * bits + 80) / 17 : (49 * bits + 57) / 17;
+}
+
+/**
+ * @brief Constant-time inverse of x modulo an odd m, for 0 <= x < m.
+ *
+ * Time and memory accesses depend only on Limbs and the bit length of m, not on x.
+ * The return value is the only data-dependent branch: it reveals whether x is
+ * invertible.
+ *
+ * @param[in] x The value to invert, in [0, m).
+ * @param[in] m The modulus; must be odd.
+ * @param[out] inverse Receives the inverse in [0, m) on success.
+ * @return true if gcd(x, m) = 1.
+ */
+template <std::size_t Limbs>
+bool safegcd_inverse(const BigUInt<Limbs> &x, const BigUInt<Limbs> &m, BigUInt<Limbs> &inverse)
+{
+    // Enough limbs for values in (-2m, 2m) plus the sign
+    constexpr std::size_t COUNT = (64 * Limbs) / 62 + 2;
+
+    // m^-1 mod 2^64 by Newton's iteration (each step doubles the correct low bits)
+    std::uint64_t m_inverse = m[0];
+    for (int i = 0; i < 5; ++i)
+        m_inverse *= 2 - m[0] * m_inverse;
+
+    Signed62<COUNT> modulus = to_signed62<COUNT>(m);
+    Signed62<COUNT> f = modulus;
+    Signed62<COUNT> g = to_signed62<COUNT>(x);
+    Signed62<COUNT> d = {};
+    Signed62<COUNT> e = {};
+    e.limb[0] = 1;
+
+    std::size_t batches = (safegcd_divstep_bound(m.bitLength()) + SAFEGCD_BATCH_STEPS - 1) /
+                          SAFEGCD_BATCH_STEPS;
+    std::int64_t delta = 1;
+    SafegcdMatrix t;
+    for (std::size_t i = 0; i < batches; ++i)
+    {
+        delta = safegcd_divsteps(delta, static_cast<std::uint64_t>(f.limb[0]),
+                                 static_cast<std::uint64_t>(g.limb[0]), t);
+        safegcd_update_de(d, e, t, modulus, m_inverse);
+        safegcd_update_fg(f, g, t);
+    }
+
+    // f = ±gcd: fold its sign into d, then bring d from (-m, m) into [0, m)
+    std::int64_t negative = f.limb[COUNT - 1] >> 63;
+    safegcd_negate_masked(f, negative);
+    safegcd_negate_masked(d, negative);
+    safegcd_add_masked(d, modulus, d.limb[COUNT - 1] >> 63);
+
+    std::int64_t other = 0;
+    for (std::size_t i = 1; i < COUNT; ++i)
+        other |= f.limb[i];
+    if (f.limb[0] != 1 || other != 0)
+        return false;
+    inverse = from_signed62<Limbs>(d);
+    return true;
+}
+
+/**
+ * @name Fixed-width views of the unsigned magnitudes used by safegcd_mod_inverse()
+ * @{
+ */
+inline BigUInt<1> to_big_uint(unsigned long long value) { return BigUInt<1>(value); }
+inline BigUInt<1> to_big_uint(unsigned long value) { return BigUInt<1>(value); }
+inline BigUInt<1> to_big_uint(unsigned int value) { return BigUInt<1>(value); }
+
+inline BigUInt<2> to_big_uint(unsigned __int128 value)
+{
+    BigUInt<2> out;
+    out[0] = static_cast<std::uint64_t>(value);
+    out[1] = static_cast<std::uint64_t>(value >> 64);
+    return out;
+}
+
+template <std::size_t Limbs>
+const BigUInt<Limbs> &to_big_uint(const BigUInt<Limbs> &value)
+{
+    return value;
+}
+
+inline void from_big_uint(const BigUInt<1> &value, unsigned long long &out) { out = value[0]; }
+inline void from_big_uint(const BigUInt<1> &value, unsigned long &out) { out = value[0]; }
+
+inline void from_big_uint(const BigUInt<1> &value, unsigned int &out)
+{
+    out = static_cast<unsigned int>(value[0]);
+}
+
+inline void from_big_uint(const BigUInt<2> &value, unsigned __int128 &out)
+{
+    out = (static_cast<unsigned __int128>(value[1]) << 64) | value[0];
+}
+
+template <std::size_t Limbs>
+void from_big_uint(const BigUInt<Limbs> &value, BigUInt<Limbs> &out)
+{
+    out = value;
+}
+/** @} */
+
+/**
+ * @brief Finds the Modular Inverse of x modulo an odd y in constant time.
+ *
+ * Same contract as mod_inverse() for odd y. The computation itself runs in
+ * constant time (see safegcd_inverse()); an x outside [0, y) is first reduced
+ * with '%', which is not, so pass reduced values for secret operands.
+ *
+ * @tparam T A signed integer type: int32_t, int64_t, __int128 or BigInt<Limbs>.
+ * @param[in] x The integer whose modular inverse is to be found.
+ * @param[in] y The modulus; must be odd and positive.
+ * @return The modular inverse of x modulo y in [0, y) if it exists; otherwise, -1.
+ */
+template <typename T>
+T safegcd_mod_inverse(T x, T y)
+{
+    using U = typename unsigned_magnitude<T>::type;
+    if (x < T(0) || x >= y)
+    {
+        x = x % y;
+        if (x < T(0))
+            x = x + y;
+    }
+
+    auto inverse = to_big_uint(to_magnitude(y));
+    if (!safegcd_inverse(to_big_uint(to_magnitude(x)), to_big_uint(to_magnitude(y)), inverse))
+        return T(-1); // Inverse doesn't exist
+    U magnitude;
+    from_big_uint(inverse, magnitude);
+    return from_magnitude<T>(magnitude);
+}
+
+#endif // SAFEGCD_HPP
@@ -0,0 +1,44 @@
+# ============================
+# numtheory.mk: build and link libnumtheory.a from a tool's Makefile
+# ============================
+#
+# Set NUMTHEORY_DIR to this directory and include the file after the default target:
+#
+#     NUMTHEORY_DIR := ../numtheory
+#     all: $(EXEC)
+#     include $(NUMTHEORY_DIR)/numtheory.mk
+#
+# Then compile with $(NUMTHEORY_CXXFLAGS) (plus $(NUMTHEORY_BENCH_CXXFLAGS) for
+# benchmarks), link with $(NUMTHEORY_LDLIBS), and list $(NUMTHEORY_LIB) among the
+# prerequisites of every executable. STATS and LTO are
+# passed down to the library build, so library and tool agree on them.
+
+NUMTHEORY_LIB := $(NUMTHEORY_DIR)/lib/libnumtheory.a
+
+# For Makefiles without -MMD dependency files: rebuild when a shared header changes
+NUMTHEORY_HEADERS := $(wildcard $(NUMTHEORY_DIR)/include/*.hpp)
+
+# 'make STATS=0' compiles out operation counts and timings; 'make LTO=1' enables
+# link-time optimization. Rebuild from clean (here and in the library) when switching.
+STATS ?= 1
+LTO ?= 0
+
+NUMTHEORY_CXXFLAGS := -I$(NUMTHEORY_DIR)/include
+ifeq ($(STATS),0)
+NUMTHEORY_CXXFLAGS += -DMONTGOMERY_NO_STATS
+endif
+ifeq ($(LTO),1)
+NUMTHEORY_CXXFLAGS += -flto=auto
+endif
+NUMTHEORY_LDLIBS := -L$(NUMTHEORY_DIR)/lib -lnumtheory
+
+# Benchmarks also include test/bench_harness.hpp, the shared timing loop and report
+NUMTHEORY_BENCH_CXXFLAGS := -I$(NUMTHEORY_DIR)/test
+NUMTHEORY_BENCH_HEADERS := $(NUMTHEORY_DIR)/test/bench_harness.hpp
+
+# Build (or refresh) the library with its own Makefile
+$(NUMTHEORY_LIB): FORCE
+	$(MAKE) -C $(NUMTHEORY_DIR) STATS=$(STATS) LTO=$(LTO) lib/libnumtheory.a
+
+.PHONY: FORCE
+FORCE:
@@ -0,0 +1,18 @@
+#include "exp_stats.hpp"
+#include <sstream>
+
+std::string ExpStats::toJson() const
+{
+    std::ostringstream out;
+    out << "{\"engine\":\"" << expEngineName(engine) << "\""
+        << ",\"window_bits\":" << windowBits
+        << ",\"exponent_bits\":" << exponentBits
+        << ",\"operations\":" << operations
+        << ",\"squarings\":" << squarings
+        << ",\"multiplications\":" << multiplications
+        << ",\"reductions\":" << reductions
+        << ",\"elapsed_ns\":" << elapsedNanoseconds
+        << ",\"cycles\":" << cycles
+        << ",\"stats_enabled\":" << (expStatsEnabled() ? "true" : "false") << "}";
+    return out.str();
+}
@@ -0,0 +1,99 @@
+#include "fixed_base_exp.hpp"
+#include <iostream>
+
+namespace
+{
+
+// Bits of a non-negative long long exponent
+constexpr std::size_t EXPONENT_BITS = 63;
+
+long long checkedModulus(long long n)
+{
+    if (n <= 0)
+    {
+        throw std::invalid_argument("FixedBaseExp: modulus must be positive");
+    }
+    return n;
+}
+
+long long reduceBase(long long g, long long n)
+{
+    long long reduced = g % n;
+    return reduced < 0 ? reduced + n : reduced;
+}
+
+std::variant<BasicFixedBaseExp<MontgomeryContext>, BasicFixedBaseExp<PlainModularContext>>
+makeTable(long long g, long long n, std::size_t windowBits)
+{
+    const std::uint64_t modulus = static_cast<std::uint64_t>(n);
+    const std::uint64_t base = static_cast<std::uint64_t>(g);
+    if (modulus & 1)
+    {
+        return BasicFixedBaseExp<MontgomeryContext>(MontgomeryContext(modulus), base,
+                                                    EXPONENT_BITS, windowBits);
+    }
+    return BasicFixedBaseExp<PlainModularContext>(PlainModularContext(modulus), base,
+                                                  EXPONENT_BITS, windowBits);
+}
+
+} // namespace
+
+FixedBaseExp::FixedBaseExp(long long g, long long n, std::size_t windowBits)
+    : g_(reduceBase(g, checkedModulus(n))),
+      n_(n),
+      table_(makeTable(g_, n_, windowBits))
+{
+}
+
+long long FixedBaseExp::compute(long long b)
+{
+    if (b < 0)
+    {
+        throw std::invalid_argument("FixedBaseExp::compute: exponent must be non-negative");
+    }
+    const std::uint64_t exponent = static_cast<std::uint64_t>(b);
+    return std::visit([exponent](auto &table)
+                      { return static_cast<long long>(table.compute(exponent)); },
+                      table_);
+}
+
+void FixedBaseExp::printStats(long long b) const
+{
+    std::cout << "[FixedBaseExp::printStats]" << std::endl;
+    std::cout << g_ << "^" << b << " mod " << n_ << " = " << getResult() << std::endl;
+    std::cout << "Window bits: " << getWindowBits() << ", table entries: " << getTableEntries()
+              << std::endl;
+    std::cout << "Number of multiplications performed: "
+              << getMultiplicationCount() << std::endl;
+}
+
+long long FixedBaseExp::getBase() const
+{
+    return g_;
+}
+
+long long FixedBaseExp::getModulus() const
+{
+    return n_;
+}
+
+std::size_t FixedBaseExp::getWindowBits() const
+{
+    return std::visit([](const auto &table) { return table.windowBits(); }, table_);
+}
+
+std::size_t FixedBaseExp::getTableEntries() const
+{
+    return std::visit([](const auto &table) { return table.tableEntries(); }, table_);
+}
+
+long long FixedBaseExp::getResult() const
+{
+    return std::visit([](const auto &table) { return static_cast<long long>(table.getResult()); },
+                      table_);
+}
+
+long long FixedBaseExp::getMultiplicationCount() const
+{
+    return std::visit([](const auto &table) { return table.getMultiplicationCount(); }, table_);
+}
@@ -0,0 +1,26 @@
+#include "montgomery_context.hpp"
+#include <stdexcept>
+
+MontgomeryContext::MontgomeryContext(std::uint64_t n)
+    : n_(n),
+      nPrime_(0),
+      one_(0),
+      r2_(0)
+{
+    if ((n & 1) == 0 || n >= (std::uint64_t(1) << 63))
+    {
+        throw std::invalid_argument("MontgomeryContext: modulus must be odd and below 2^63");
+    }
+
+    // Newton iteration for n^-1 mod 2^64; each step doubles the correct low bits
+    std::uint64_t inverse = n; // Correct to 3 bits for odd n
+    for (int i = 0; i < 5; ++i)
+    {
+        inverse *= 2 - n * inverse;
+    }
+    nPrime_ = ~inverse + 1;
+
+    // The only divisions: R mod n = (2^64 - n) mod n, and R^2 mod n
+    one_ = (~n + 1) % n;
+    r2_ = static_cast<std::uint64_t>(static_cast<unsigned __int128>(one_) * one_ % n);
+}
@@ -0,0 +1,177 @@
+#include "montgomery_exp.hpp"
+#include "batch_exp.hpp"
+#include "montgomery_context.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <iostream>
+#include <stdexcept>
+
+MontgomeryExp::MontgomeryExp()
+    : result_(0),
+      multiplicationCount_(0),
+      engine_(ExpEngine::SlidingWindow),
+      windowBits_(0),
+      threads_(0)
+{
+    // Constructor body (if needed, otherwise it’s enough to have the initializer list)
+}
+
+long long MontgomeryExp::compute(long long a, long long b, long long n)
+{
+    if (n <= 0)
+    {
+        throw std::invalid_argument("MontgomeryExp::compute: modulus must be positive");
+    }
+    if (b < 0)
+    {
+        throw std::invalid_argument("MontgomeryExp::compute: exponent must be non-negative");
+    }
+
+    StatsTimer timer;
+    const std::uint64_t modulus = static_cast<std::uint64_t>(n);
+    const std::uint64_t exponent = static_cast<std::uint64_t>(b);
+    ExpStats stats = makeExpStats(engine_, windowBits_, exponent);
+
+    // Reduce base 'a' into [0, n), including negative bases
+    long long reduced = a % n;
+    std::uint64_t base = static_cast<std::uint64_t>(reduced < 0 ? reduced + n : reduced);
+
+    ExpCounters counters;
+    if (modulus & 1)
+    {
+        // Entirely in Montgomery form: no divisions inside the exponentiation
+        MontgomeryContext ctx(modulus);
+        std::uint64_t x = ctx.toMontgomery(base);
+        x = exponentiate(ctx, x, exponent, engine_, windowBits_, counters);
+        result_ = static_cast<long long>(ctx.fromMontgomery(x));
+    }
+    else
+    {
+        // Montgomery reduction needs an odd modulus; fall back to 128-bit products and '%'
+        PlainModularContext ctx(modulus);
+        result_ = static_cast<long long>(exponentiate(ctx, base, exponent, engine_, windowBits_,
+                                                      counters));
+    }
+    recordCounters(stats, counters, (modulus & 1) ? 2 : 0);
+    timer.stop(stats);
+    stats_ = stats;
+    multiplicationCount_ = stats_.products();
+    return result_;
+}
+
+void MontgomeryExp::computeBatch(const long long *bases, const long long *exps,
+                                 std::size_t count, long long n, long long *results)
+{
+    if (n <= 0)
+    {
+        throw std::invalid_argument("MontgomeryExp::computeBatch: modulus must be positive");
+    }
+
+    StatsTimer timer;
+    ExpStats stats;
+    stats.engine = batchEngine(engine_);
+    stats.operations = count;
+
+    const std::uint64_t modulus = static_cast<std::uint64_t>(n);
+    std::vector<std::uint64_t> reducedBases(count);
+    std::vector<std::uint64_t> exponents(count);
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        if (exps[i] < 0)
+        {
+            throw std::invalid_argument(
+                "MontgomeryExp::computeBatch: exponents must be non-negative");
+        }
+        long long reduced = bases[i] % n;
+        reducedBases[i] = static_cast<std::uint64_t>(reduced < 0 ? reduced + n : reduced);
+        exponents[i] = static_cast<std::uint64_t>(exps[i]);
+        stats.exponentBits =
+            std::max(stats.exponentBits, statsExponentBits(stats.engine, exponents[i]));
+    }
+    stats.windowBits = batchWindowBits(engine_, windowBits_, exponents.data(), count);
+
+    // Reuse the input buffer for the outputs; both are plain residues
+    ExpCounters counters;
+    if (modulus & 1)
+    {
+        MontgomeryContext ctx(modulus);
+        exponentiateBatch(ctx, reducedBases.data(), exponents.data(), reducedBases.data(), count,
+                          engine_, windowBits_, threads_, counters);
+    }
+    else
+    {
+        PlainModularContext ctx(modulus);
+        exponentiateBatch(ctx, reducedBases.data(), exponents.data(), reducedBases.data(), count,
+                          engine_, windowBits_, threads_, counters);
+    }
+
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        results[i] = static_cast<long long>(reducedBases[i]);
+    }
+    recordCounters(stats, counters, (modulus & 1) ? 2 * static_cast<long long>(count) : 0);
+    timer.stop(stats);
+    stats_ = stats;
+    multiplicationCount_ = stats_.products();
+    if (count > 0)
+    {
+        result_ = results[count - 1];
+    }
+}
+
+std::vector<long long> MontgomeryExp::computeBatch(const std::vector<long long> &bases,
+                                                   const std::vector<long long> &exps, long long n)
+{
+    if (bases.size() != exps.size())
+    {
+        throw std::invalid_argument(
+            "MontgomeryExp::computeBatch: bases and exponents differ in length");
+    }
+    std::vector<long long> results(bases.size());
+    computeBatch(bases.data(), exps.data(), bases.size(), n, results.data());
+    return results;
+}
+
+void MontgomeryExp::setThreads(std::size_t threads)
+{
+    threads_ = threads;
+}
+
+std::size_t MontgomeryExp::getThreads() const
+{
+    return threads_;
+}
+
+void MontgomeryExp::setEngine(ExpEngine engine, std::size_t windowBits)
+{
+    engine_ = engine;
+    windowBits_ = windowBits;
+}
+
+ExpEngine MontgomeryExp::getEngine() const
+{
+    return engine_;
+}
+
+void MontgomeryExp::printStats(long long a, long long b, long long n) const
+{
+    std::cout << "[MontgomeryExp::printStats]" << std::endl;
+    std::cout << a << "^" << b << " mod " << n << " = " << result_ << std::endl;
+    std::cout << "Number of multiplications performed: "
+              << multiplicationCount_ << std::endl;
+}
+
+long long MontgomeryExp::getResult() const
+{
+    return result_;
+}
+
+long long MontgomeryExp::getMultiplicationCount() const
+{
+    return multiplicationCount_;
+}
+
+const ExpStats &MontgomeryExp::getStats() const
+{
+    return stats_;
+}
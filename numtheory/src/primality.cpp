@@ -0,0 +1,104 @@
+#include "primality.hpp"
+#include "montgomery_context.hpp"
+#include <memory>
+
+namespace
+{
+
+// Deterministic Miller–Rabin bases for n < 2^64 (Jim Sinclair, 2011)
+constexpr std::uint64_t WORD_BASES[] = {2, 325, 9375, 28178, 450775, 9780504, 1795265022};
+
+template <class Context>
+bool passesWordBases(const Context &ctx, std::uint64_t n, std::uint64_t d, std::size_t s)
+{
+    using Value = typename Context::Value;
+    for (std::uint64_t base : WORD_BASES)
+    {
+        std::uint64_t reduced = base % n;
+        if (reduced != 0 && !millerRabin(ctx, Value(reduced), Value(d), s))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+int jacobiSymbol(std::uint64_t a, std::uint64_t n)
+{
+    a %= n;
+    int result = 1;
+    while (a != 0)
+    {
+        // (2/n) = -1 exactly when n is 3 or 5 mod 8
+        int twos = __builtin_ctzll(a);
+        a >>= twos;
+        if ((twos & 1) && ((n & 7) == 3 || (n & 7) == 5))
+        {
+            result = -result;
+        }
+        // Quadratic reciprocity: swapping negates when both are 3 mod 4
+        if ((a & 3) == 3 && (n & 3) == 3)
+        {
+            result = -result;
+        }
+        std::uint64_t t = a;
+        a = n % t;
+        n = t;
+    }
+    return n == 1 ? result : 0;
+}
+
+bool isPrime(std::uint64_t n)
+{
+    if (n < 2)
+    {
+        return false;
+    }
+    if ((n & 1) == 0)
+    {
+        return n == 2;
+    }
+    for (std::size_t i = 0; i < WORD_TRIAL_PRIMES; ++i)
+    {
+        std::uint64_t p = SMALL_PRIMES[i];
+        if (p * p > n)
+        {
+            return true;
+        }
+        if (n % p == 0)
+        {
+            return n == p;
+        }
+    }
+
+    std::size_t s = __builtin_ctzll(n - 1);
+    std::uint64_t d = (n - 1) >> s;
+    if (n < (std::uint64_t(1) << 63))
+    {
+        return passesWordBases(MontgomeryContext(n), n, d, s);
+    }
+    // MontgomeryContext needs n < 2^63; the one-limb CIOS context covers the top bit
+    return passesWordBases(BigMontgomeryContext<1>(BigUInt<1>(n)), n, d, s);
+}
+
+void isPrimeBatch(const std::uint64_t *candidates, bool *results, std::size_t count,
+                  std::size_t threads)
+{
+    parallelChunks(count, PRIMALITY_WORDS_PER_THREAD, threads,
+                   [&](std::size_t begin, std::size_t end, std::size_t)
+                   {
+                       for (std::size_t i = begin; i < end; ++i)
+                       {
+                           results[i] = isPrime(candidates[i]);
+                       }
+                   });
+}
+
+std::vector<bool> isPrimeBatch(const std::vector<std::uint64_t> &candidates, std::size_t threads)
+{
+    std::unique_ptr<bool[]> flags(new bool[candidates.size()]);
+    isPrimeBatch(candidates.data(), flags.get(), candidates.size(), threads);
+    return std::vector<bool>(flags.get(), flags.get() + candidates.size());
+}
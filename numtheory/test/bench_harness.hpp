@@ -0,0 +1,217 @@
+#ifndef BENCH_HARNESS_H
+#define BENCH_HARNESS_H
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+/**
+ * @file bench_harness.hpp
+ * @brief Timing loop, command line and CSV/JSON report shared by the tools' benchmarks.
+ *
+ * Each benchmark fixes its operands, cross-checks the engines, and records
+ * one row per measurement in a BenchReport. Rows start with the operand
+ * size in bits, then the benchmark's own label columns, the operation count
+ * and time, the derived rate and time per operation, any extra numeric
+ * columns, and whether the row was verified.
+ */
+
+/** @brief Default minimum wall time per measurement, in seconds. */
+constexpr double BENCH_MIN_SECONDS = 0.25;
+
+/** @brief Values the timed loops fold into so the compiler cannot drop them. */
+inline volatile std::uint64_t benchSink;
+
+inline double benchNow()
+{
+    return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+}
+
+/**
+ * @brief Run body(i % poolSize) in doubling batches until minSeconds have elapsed.
+ *
+ * @return {operations, seconds}
+ */
+template <class Body>
+std::pair<double, double> benchLoop(std::size_t poolSize, Body body,
+                                    double minSeconds = BENCH_MIN_SECONDS)
+{
+    double ops = 0;
+    double start = benchNow();
+    double elapsed = 0;
+    std::size_t batch = 4;
+    std::size_t i = 0;
+    do
+    {
+        for (std::size_t it = 0; it < batch; ++it, ++i)
+        {
+            body(i % poolSize);
+        }
+        ops += static_cast<double>(batch);
+        batch *= 2;
+        elapsed = benchNow() - start;
+    } while (elapsed < minSeconds);
+    return {ops, elapsed};
+}
+
+/**
+ * @brief Options common to the benchmarks: --format csv|json and --max-bits <bits>.
+ */
+struct BenchArgs
+{
+    bool json = false;
+    std::size_t maxBits = 2048;
+};
+
+/**
+ * @brief Parse the benchmark command line; prints the usage and returns false on bad input.
+ */
+inline bool parseBenchArgs(int argc, char *argv[], BenchArgs &args)
+{
+    for (int i = 1; i < argc; ++i)
+    {
+        if (std::strcmp(argv[i], "--format") == 0 && i + 1 < argc)
+        {
+            args.json = std::strcmp(argv[++i], "json") == 0;
+        }
+        else if (std::strcmp(argv[i], "--max-bits") == 0 && i + 1 < argc)
+        {
+            args.maxBits = std::strtoul(argv[++i], nullptr, 10);
+        }
+        else
+        {
+            std::cerr << "Usage: " << argv[0] << " [--format csv|json] [--max-bits <bits>]"
+                      << std::endl;
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @class BenchReport
+ * @brief Rows of measurements, printed as CSV or as a JSON array.
+ */
+class BenchReport
+{
+public:
+    /**
+     * @param labels Names of the text columns after "bits", e.g. {"engine"}
+     * @param extras Names of the numeric columns after the time per operation
+     * @param timeColumn Name of the time-per-operation column
+     * @param timeScale Units of that column per second (1e9 for nanoseconds)
+     */
+    explicit BenchReport(std::vector<std::string> labels, std::vector<std::string> extras = {},
+                         std::string timeColumn = "ns_per_op", double timeScale = 1e9)
+        : labels_(std::move(labels)),
+          extras_(std::move(extras)),
+          timeColumn_(std::move(timeColumn)),
+          timeScale_(timeScale)
+    {
+    }
+
+    /**
+     * @brief Record one measurement; labels and extras follow the constructor's columns.
+     */
+    void add(std::size_t bits, std::vector<std::string> labels, double ops, double seconds,
+             bool verified, std::vector<double> extras = {})
+    {
+        rows_.push_back({bits, std::move(labels), ops, seconds, verified, std::move(extras)});
+    }
+
+    /** @brief Operation count of the last row, for benchmarks that count several per call. */
+    double &lastOps() { return rows_.back().ops; }
+
+    void print(std::ostream &out, bool json) const
+    {
+        if (json)
+        {
+            printJson(out);
+        }
+        else
+        {
+            printCsv(out);
+        }
+    }
+
+private:
+    struct Row
+    {
+        std::size_t bits;
+        std::vector<std::string> labels;
+        double ops;
+        double seconds;
+        bool verified;
+        std::vector<double> extras;
+    };
+
+    void printCsv(std::ostream &out) const
+    {
+        out << "bits";
+        for (const std::string &name : labels_)
+        {
+            out << "," << name;
+        }
+        out << ",ops,seconds,ops_per_sec," << timeColumn_;
+        for (const std::string &name : extras_)
+        {
+            out << "," << name;
+        }
+        out << ",verified\n";
+
+        for (const Row &r : rows_)
+        {
+            out << r.bits;
+            for (const std::string &label : r.labels)
+            {
+                out << "," << label;
+            }
+            out << "," << r.ops << "," << r.seconds << "," << r.ops / r.seconds << ","
+                << r.seconds * timeScale_ / r.ops;
+            for (double extra : r.extras)
+            {
+                out << "," << extra;
+            }
+            out << "," << (r.verified ? "yes" : "no") << "\n";
+        }
+    }
+
+    void printJson(std::ostream &out) const
+    {
+        out << "[\n";
+        for (std::size_t i = 0; i < rows_.size(); ++i)
+        {
+            const Row &r = rows_[i];
+            out << "  {\"bits\": " << r.bits;
+            for (std::size_t k = 0; k < labels_.size(); ++k)
+            {
+                out << ", \"" << labels_[k] << "\": \"" << r.labels[k] << "\"";
+            }
+            out << ", \"ops\": " << r.ops << ", \"seconds\": " << r.seconds
+                << ", \"ops_per_sec\": " << r.ops / r.seconds << ", \"" << timeColumn_
+                << "\": " << r.seconds * timeScale_ / r.ops;
+            for (std::size_t k = 0; k < extras_.size(); ++k)
+            {
+                out << ", \"" << extras_[k] << "\": " << r.extras[k];
+            }
+            out << ", \"verified\": " << (r.verified ? "true" : "false") << "}"
+                << (i + 1 < rows_.size() ? "," : "") << "\n";
+        }
+        out << "]\n";
+    }
+
+    std::vector<std::string> labels_;
+    std::vector<std::string> extras_;
+    std::string timeColumn_;
+    double timeScale_;
+    std::vector<Row> rows_;
+};
+
+#endif // BENCH_HARNESS_H
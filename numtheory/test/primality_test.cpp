@@ -0,0 +1,281 @@
+/**
+ * @file primality_test.cpp
+ * @brief Known-answer tests for the primality module (run with `make test`).
+ *
+ * - isPrime() must agree with a sieve of Eratosthenes below SIEVE_LIMIT, and
+ *   reject the strong pseudoprimes that defeat the smaller deterministic
+ *   base sets (3215031751 fools bases 2 to 7, 3825123056546413051 bases 2
+ *   to 23).
+ * - Near 2^63, where the tests switch from MontgomeryContext to the one-limb
+ *   CIOS context, and below 2^64, every value in a window is checked against
+ *   the primes in it (2^63 - 25, 2^63 + 29, 2^63 + 99 and 2^64 - 59 among
+ *   them), which were found with an independent Miller–Rabin.
+ * - isProbablePrime() must accept the Mersenne primes up to 2^2281 - 1 and
+ *   reject the composite 2^p - 1 for prime p, squares of primes, products
+ *   with a factor just below and above SMALL_PRIME_LIMIT, and Carmichael
+ *   numbers above 2^64 that are base-2 strong pseudoprimes, so only the
+ *   Lucas test can reject them.
+ * - Both overloads of isPrimeBatch() and isProbablePrimeBatch() must agree
+ *   with the single-value tests.
+ *
+ * Every failed check is printed; any failure makes the test exit non-zero.
+ */
+
+#include "big_uint.hpp"
+#include "primality.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace
+{
+
+// isPrime() is compared with the sieve for every n below this bound
+constexpr std::uint64_t SIEVE_LIMIT = std::uint64_t(1) << 22;
+
+// Thread count for the batch tests, so that they always split into several chunks
+constexpr std::size_t BATCH_THREADS = 4;
+
+std::size_t checks = 0;
+std::size_t failures = 0;
+
+void check(bool ok, const std::string &what)
+{
+    checks++;
+    if (!ok)
+    {
+        failures++;
+        std::cerr << "FAIL: " << what << std::endl;
+    }
+}
+
+template <std::size_t Limbs>
+BigUInt<Limbs> powerOfTwo(std::size_t exponent)
+{
+    BigUInt<Limbs> value(1);
+    value.shiftLeft(exponent);
+    return value;
+}
+
+template <std::size_t Limbs>
+BigUInt<Limbs> mersenne(std::size_t exponent)
+{
+    return powerOfTwo<Limbs>(exponent) - BigUInt<Limbs>(1);
+}
+
+void testSieve()
+{
+    std::vector<bool> composite(SIEVE_LIMIT, false);
+    composite[0] = composite[1] = true;
+    for (std::uint64_t p = 2; p * p < SIEVE_LIMIT; ++p)
+    {
+        if (!composite[p])
+        {
+            for (std::uint64_t m = p * p; m < SIEVE_LIMIT; m += p)
+            {
+                composite[m] = true;
+            }
+        }
+    }
+
+    std::vector<std::uint64_t> candidates(SIEVE_LIMIT);
+    for (std::uint64_t n = 0; n < SIEVE_LIMIT; ++n)
+    {
+        candidates[n] = n;
+    }
+    std::unique_ptr<bool[]> batch(new bool[SIEVE_LIMIT]);
+    isPrimeBatch(candidates.data(), batch.get(), SIEVE_LIMIT, BATCH_THREADS);
+
+    // One check per disagreement type, so a broken build does not print millions of lines
+    std::size_t singleWrong = 0;
+    std::size_t batchWrong = 0;
+    for (std::uint64_t n = 0; n < SIEVE_LIMIT; ++n)
+    {
+        bool prime = !composite[n];
+        if (isPrime(n) != prime && singleWrong++ == 0)
+        {
+            std::cerr << "isPrime(" << n << ") disagrees with the sieve" << std::endl;
+        }
+        if (batch[n] != prime && batchWrong++ == 0)
+        {
+            std::cerr << "isPrimeBatch at " << n << " disagrees with the sieve" << std::endl;
+        }
+    }
+    check(singleWrong == 0, "isPrime() against the sieve below 2^22");
+    check(batchWrong == 0, "isPrimeBatch() against the sieve below 2^22");
+}
+
+void testPseudoprimes()
+{
+    // Strong pseudoprimes to every prime base up to the given one
+    const std::uint64_t strongPseudoprimes[] = {
+        2047,                // 23 * 89, base 2
+        1373653,             // 829 * 1657, bases 2 and 3
+        25326001,            // 2251 * 11251, bases 2 to 5
+        3215031751,          // 151 * 751 * 28351, bases 2 to 7
+        3474749660383,       // 1303 * 16927 * 157543, bases 2 to 13
+        341550071728321,     // 10670053 * 32010157, bases 2 to 17
+        3825123056546413051, // 149491 * 747451 * 34233211, bases 2 to 23
+    };
+    for (std::uint64_t n : strongPseudoprimes)
+    {
+        check(!isPrime(n), "isPrime(" + std::to_string(n) + ") rejects a strong pseudoprime");
+    }
+
+    // Carmichael numbers, and squares of primes at both ends of the word range
+    const std::uint64_t composites[] = {561, 1105, 1729, 2465, 2821, 6601, 8911,
+                                        4093ULL * 4093ULL, 4294967291ULL * 4294967291ULL};
+    for (std::uint64_t n : composites)
+    {
+        check(!isPrime(n), "isPrime(" + std::to_string(n) + ") rejects a composite");
+    }
+}
+
+// Every value base + k for k in [first, last] is prime exactly when k is listed in primes
+void testWindow(std::uint64_t base, long first, long last, const std::vector<long> &primes,
+                const std::string &name)
+{
+    std::vector<std::uint64_t> candidates;
+    std::vector<bool> expected;
+    for (long k = first; k <= last; ++k)
+    {
+        candidates.push_back(base + static_cast<std::uint64_t>(k));
+        bool prime = false;
+        for (long p : primes)
+        {
+            prime = prime || p == k;
+        }
+        expected.push_back(prime);
+    }
+
+    std::vector<bool> batch = isPrimeBatch(candidates, BATCH_THREADS);
+    for (std::size_t i = 0; i < candidates.size(); ++i)
+    {
+        std::string what = name + (first + long(i) < 0 ? " - " : " + ") +
+                           std::to_string(std::labs(first + long(i)));
+        check(isPrime(candidates[i]) == expected[i], "isPrime(" + what + ")");
+        check(batch[i] == expected[i], "isPrimeBatch(" + what + ")");
+    }
+}
+
+void testWordBoundaries()
+{
+    const std::uint64_t twoTo63 = std::uint64_t(1) << 63;
+    testWindow(twoTo63, -100, 100, {-25, 29, 99}, "2^63");
+    // 2^64 - k for k in [1, 200]: start at 2^64 - 200 and count up
+    testWindow(0 - std::uint64_t(200), 0, 199, {200 - 189, 200 - 179, 200 - 95, 200 - 83, 200 - 59},
+               "(2^64 - 200)");
+    check(isPrime(~std::uint64_t(0) - 58), "isPrime(2^64 - 59)");
+    check(!isPrime(~std::uint64_t(0)), "isPrime(2^64 - 1) is false");
+}
+
+template <std::size_t Limbs>
+void expectProbablePrime(const BigUInt<Limbs> &n, bool prime, const std::string &name)
+{
+    check(isProbablePrime(n) == prime,
+          "isProbablePrime(" + name + ") is " + (prime ? "true" : "false"));
+}
+
+template <std::size_t Limbs>
+void testMersenne(const std::vector<std::size_t> &primeExponents,
+                  const std::vector<std::size_t> &compositeExponents)
+{
+    for (std::size_t p : primeExponents)
+    {
+        expectProbablePrime(mersenne<Limbs>(p), true, "2^" + std::to_string(p) + " - 1");
+    }
+    for (std::size_t p : compositeExponents)
+    {
+        expectProbablePrime(mersenne<Limbs>(p), false, "2^" + std::to_string(p) + " - 1");
+    }
+}
+
+void testBpsw()
+{
+    // Mersenne exponents p are prime; 2^p - 1 is prime only for the first list
+    testMersenne<2>({61, 89, 107, 127}, {67, 101, 103, 109, 113});
+    testMersenne<10>({521, 607}, {523, 541, 601});
+    testMersenne<20>({1279}, {1277});
+    testMersenne<36>({2203, 2281}, {2207, 2237});
+
+    // Squares pass trial division by construction; the Lucas test must not accept them
+    BigUInt<4> m89 = mersenne<4>(89);
+    BigUInt<4> m127 = mersenne<4>(127);
+    expectProbablePrime(m89 * m89, false, "(2^89 - 1)^2");
+    expectProbablePrime(m127 * m127, false, "(2^127 - 1)^2");
+    expectProbablePrime(m89 * m127, false, "(2^89 - 1)(2^127 - 1)");
+    BigUInt<20> m521 = mersenne<20>(521);
+    expectProbablePrime(m521 * m521, false, "(2^521 - 1)^2");
+
+    // Largest table prime, and the first prime above the table
+    expectProbablePrime(BigUInt<4>(4093) * m127, false, "4093 (2^127 - 1)");
+    expectProbablePrime(BigUInt<4>(4099) * m127, false, "4099 (2^127 - 1)");
+
+    // Carmichael numbers (6k + 1)(12k + 1)(18k + 1) that are base-2 strong pseudoprimes
+    for (const char *text : {"18768001878618448249", "18870750366864670441",
+                             "19098863462258318521"})
+    {
+        expectProbablePrime(BigUInt<2>::fromString(text), false, text);
+    }
+
+    // Values that fit in a word go to isPrime()
+    expectProbablePrime(BigUInt<2>(3825123056546413051ULL), false, "3825123056546413051");
+    expectProbablePrime(BigUInt<2>(~std::uint64_t(0) - 58), true, "2^64 - 59");
+}
+
+void testProbablePrimeBatch()
+{
+    // 2^64 + k for k in [1, 200]; the primes are at k = 13, 37, 51, 81, 93 and 141
+    std::vector<BigUInt<2>> words;
+    std::vector<bool> expected;
+    for (std::uint64_t k = 1; k <= 200; ++k)
+    {
+        words.push_back(powerOfTwo<2>(64) + BigUInt<2>(k));
+        expected.push_back(k == 13 || k == 37 || k == 51 || k == 81 || k == 93 || k == 141);
+    }
+    std::unique_ptr<bool[]> flags(new bool[words.size()]);
+    isProbablePrimeBatch(words.data(), flags.get(), words.size(), BATCH_THREADS);
+    for (std::size_t i = 0; i < words.size(); ++i)
+    {
+        std::string what = "2^64 + " + std::to_string(i + 1);
+        check(isProbablePrime(words[i]) == expected[i], "isProbablePrime(" + what + ")");
+        check(flags[i] == expected[i], "isProbablePrimeBatch(" + what + ")");
+    }
+
+    // Mersenne numbers 2^p - 1 for every p up to 127 (prime exactly for the Mersenne exponents)
+    std::vector<BigUInt<2>> big;
+    for (std::size_t p = 2; p <= 127; ++p)
+    {
+        big.push_back(mersenne<2>(p));
+    }
+    std::vector<bool> batch = isProbablePrimeBatch(big, BATCH_THREADS);
+    const std::size_t mersenneExponents[] = {2, 3, 5, 7, 13, 17, 19, 31, 61, 89, 107, 127};
+    for (std::size_t i = 0; i < big.size(); ++i)
+    {
+        std::size_t p = i + 2;
+        bool prime = false;
+        for (std::size_t e : mersenneExponents)
+        {
+            prime = prime || e == p;
+        }
+        check(batch[i] == prime, "isProbablePrimeBatch(2^" + std::to_string(p) + " - 1)");
+    }
+}
+
+} // namespace
+
+int main()
+{
+    testSieve();
+    testPseudoprimes();
+    testWordBoundaries();
+    testBpsw();
+    testProbablePrimeBatch();
+
+    std::cout << (checks - failures) << "/" << checks << " primality checks passed" << std::endl;
+    return failures == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
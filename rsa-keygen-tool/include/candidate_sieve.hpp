@@ -0,0 +1,131 @@
+#ifndef CANDIDATE_SIEVE_H
+#define CANDIDATE_SIEVE_H
+
+#include "big_uint.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/** @brief Candidates are sieved by the odd primes below this bound. */
+constexpr std::uint32_t SIEVE_PRIME_LIMIT = 1 << 16;
+
+/** @brief Odd candidates per sieve window (the window spans twice as many integers). */
+constexpr std::uint32_t SIEVE_WINDOW = 4096;
+
+/**
+ * @brief The odd primes below SIEVE_PRIME_LIMIT, computed on first use.
+ */
+const std::vector<std::uint32_t> &sievePrimes();
+
+/**
+ * @class CandidateSieve
+ * @brief Incremental sieve of Eratosthenes over consecutive odd candidates.
+ *
+ * Covers the window base, base + 2, ..., base + 2·(SIEVE_WINDOW - 1). The
+ * residues of base modulo every sieve prime are computed once, from one
+ * reduction per word-sized product of primes. Each prime then strikes out
+ * its multiples in the window directly. advance() moves to the next window
+ * by adding 2·SIEVE_WINDOW to the residues, with no multi-limb arithmetic.
+ *
+ * About 10% of the odd candidates survive, against 13.5% for the sieve of
+ * primality.hpp, and a survivor costs no long division.
+ */
+template <std::size_t Limbs>
+class CandidateSieve
+{
+public:
+    using Value = BigUInt<Limbs>;
+
+    /**
+     * @brief Sieve the first window.
+     *
+     * @param base First candidate; must be odd and above SIEVE_PRIME_LIMIT
+     */
+    explicit CandidateSieve(const Value &base)
+        : base_(base),
+          residues_(sievePrimes().size()),
+          composite_(SIEVE_WINDOW)
+    {
+        const std::vector<std::uint32_t> &primes = sievePrimes();
+        for (std::size_t i = 0; i < primes.size();)
+        {
+            // Reduce base once per group of primes whose product fits in a word
+            std::uint64_t product = 1;
+            std::size_t end = i;
+            while (end < primes.size() && product <= UINT64_MAX / primes[end])
+            {
+                product *= primes[end++];
+            }
+            std::uint64_t remainder = base.modSmall(product);
+            for (; i < end; ++i)
+            {
+                residues_[i] = static_cast<std::uint32_t>(remainder % primes[i]);
+            }
+        }
+        sieveWindow();
+    }
+
+    /**
+     * @brief Offsets j of the window's survivors: the candidates base + 2j without a
+     *        factor below SIEVE_PRIME_LIMIT, in ascending order.
+     */
+    const std::vector<std::uint32_t> &survivors() const { return survivors_; }
+
+    /**
+     * @brief The candidate base + 2·offset of the current window.
+     */
+    Value candidate(std::uint32_t offset) const
+    {
+        Value value = base_;
+        value.addInPlace(Value(2 * static_cast<std::uint64_t>(offset)));
+        return value;
+    }
+
+    /**
+     * @brief Move to the next window and sieve it.
+     */
+    void advance()
+    {
+        const std::vector<std::uint32_t> &primes = sievePrimes();
+        for (std::size_t i = 0; i < primes.size(); ++i)
+        {
+            residues_[i] =
+                static_cast<std::uint32_t>((residues_[i] + 2 * SIEVE_WINDOW) % primes[i]);
+        }
+        base_.addInPlace(Value(2 * static_cast<std::uint64_t>(SIEVE_WINDOW)));
+        sieveWindow();
+    }
+
+private:
+    void sieveWindow()
+    {
+        const std::vector<std::uint32_t> &primes = sievePrimes();
+        std::fill(composite_.begin(), composite_.end(), 0);
+        for (std::size_t i = 0; i < primes.size(); ++i)
+        {
+            // base + 2j ≡ 0 (mod p) for j ≡ -base·2^-1 = (p - r)·(p + 1)/2 (mod p)
+            std::uint64_t p = primes[i];
+            std::uint64_t j = (p - residues_[i]) % p * ((p + 1) / 2) % p;
+            for (; j < SIEVE_WINDOW; j += p)
+            {
+                composite_[j] = 1;
+            }
+        }
+        survivors_.clear();
+        for (std::uint32_t j = 0; j < SIEVE_WINDOW; ++j)
+        {
+            if (!composite_[j])
+            {
+                survivors_.push_back(j);
+            }
+        }
+    }
+
+    Value base_;                           ///< First candidate of the current window
+    std::vector<std::uint32_t> residues_;  ///< base_ mod sievePrimes()[i]
+    std::vector<std::uint8_t> composite_;  ///< Window flags: candidate has a small factor
+    std::vector<std::uint32_t> survivors_; ///< Offsets of the unflagged candidates
+};
+
+#endif // CANDIDATE_SIEVE_H
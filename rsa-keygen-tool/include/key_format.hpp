@@ -0,0 +1,59 @@
+#ifndef KEY_FORMAT_H
+#define KEY_FORMAT_H
+
+#include "rsa_keygen.hpp"
+#include <ostream>
+#include <string>
+
+/**
+ * @brief Output formats of the key generator.
+ */
+enum class KeyFormat
+{
+    Csv,  ///< One line per key: n,e,d,p,q,dp,dq,qinv in 0x-prefixed hex
+    Json, ///< One JSON object per line, same fields as Csv
+    Pem   ///< PKCS#1 "RSA PRIVATE KEY" blocks, readable by OpenSSL
+};
+
+/**
+ * @brief The fields of a key in 0x-prefixed lowercase hex, in PKCS#1 order.
+ */
+struct KeyText
+{
+    std::string n;
+    std::string e;
+    std::string d;
+    std::string p;
+    std::string q;
+    std::string dp;
+    std::string dq;
+    std::string qinv;
+};
+
+/**
+ * @brief Render the fields of key as hex.
+ */
+template <std::size_t HalfLimbs>
+KeyText keyText(const RsaKey<HalfLimbs> &key)
+{
+    return KeyText{key.n.toHex(),      BigUInt<1>(key.e).toHex(), key.d.toHex(),
+                   key.crt.p.toHex(),  key.crt.q.toHex(),         key.crt.dp.toHex(),
+                   key.crt.dq.toHex(), key.crt.qinv.toHex()};
+}
+
+/**
+ * @brief Parse a format name (csv, json or pem); false if it is unknown.
+ */
+bool parseKeyFormat(const std::string &name, KeyFormat &format);
+
+/**
+ * @brief Write the CSV header line; nothing for the other formats.
+ */
+void writeKeyHeader(std::ostream &out, KeyFormat format);
+
+/**
+ * @brief Write one key in the given format, ending with a newline.
+ */
+void writeKey(std::ostream &out, const KeyText &key, KeyFormat format);
+
+#endif // KEY_FORMAT_H
@@ -0,0 +1,81 @@
+#ifndef RANDOM_SOURCE_H
+#define RANDOM_SOURCE_H
+
+#include "big_uint.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <random>
+
+/**
+ * @class RandomSource
+ * @brief Random words for prime searches: operating-system entropy, or a seeded stream.
+ *
+ * The default source reads std::random_device, which draws from the
+ * operating system's generator on Linux. The seeded source is a Mersenne
+ * Twister keyed by (seed, stream, attempt). It makes key sets reproducible
+ * for test fixtures but is predictable, so it must not be used for real keys.
+ */
+class RandomSource
+{
+public:
+    /**
+     * @brief Source backed by std::random_device.
+     */
+    RandomSource() : seeded_(false) {}
+
+    /**
+     * @brief Deterministic source for one prime search.
+     *
+     * @param seed Seed of the whole run
+     * @param stream Index of the search within the run
+     * @param attempt Retry counter, for searches whose prime was rejected
+     */
+    RandomSource(std::uint64_t seed, std::uint64_t stream, std::uint64_t attempt) : seeded_(true)
+    {
+        std::seed_seq sequence{static_cast<std::uint32_t>(seed),
+                               static_cast<std::uint32_t>(seed >> 32),
+                               static_cast<std::uint32_t>(stream),
+                               static_cast<std::uint32_t>(stream >> 32),
+                               static_cast<std::uint32_t>(attempt)};
+        engine_.seed(sequence);
+    }
+
+    std::uint64_t next()
+    {
+        if (seeded_)
+        {
+            return engine_();
+        }
+        return (static_cast<std::uint64_t>(device_()) << 32) | device_();
+    }
+
+    /**
+     * @brief Random odd value of exactly bits bits whose top two bits are set.
+     *
+     * The product of two such values has exactly 2·bits bits.
+     */
+    template <std::size_t Limbs>
+    BigUInt<Limbs> oddWithTopBits(std::size_t bits)
+    {
+        BigUInt<Limbs> value;
+        for (std::size_t i = 0; i * 64 < bits; ++i)
+        {
+            value[i] = next();
+        }
+        if (bits % 64 != 0)
+        {
+            value[bits / 64] &= (std::uint64_t(1) << (bits % 64)) - 1;
+        }
+        value[(bits - 1) / 64] |= std::uint64_t(1) << ((bits - 1) % 64);
+        value[(bits - 2) / 64] |= std::uint64_t(1) << ((bits - 2) % 64);
+        value[0] |= 1;
+        return value;
+    }
+
+private:
+    bool seeded_;                ///< Use engine_ rather than device_
+    std::mt19937_64 engine_;     ///< Seeded stream
+    std::random_device device_;  ///< Operating-system entropy
+};
+
+#endif // RANDOM_SOURCE_H
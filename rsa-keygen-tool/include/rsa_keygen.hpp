@@ -0,0 +1,326 @@
+#ifndef RSA_KEYGEN_H
+#define RSA_KEYGEN_H
+
+#include "big_int.hpp"
+#include "candidate_sieve.hpp"
+#include "gcd_engine.hpp"
+#include "montgomery_big.hpp"
+#include "primality.hpp"
+#include "random_source.hpp"
+#include "rsa_crt.hpp"
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+/** @brief Default public exponent, F4 = 2^16 + 1. */
+constexpr std::uint64_t RSA_DEFAULT_EXPONENT = 65537;
+
+/**
+ * @brief RSA key pair; the modulus has 128·HalfLimbs bits at most.
+ */
+template <std::size_t HalfLimbs>
+struct RsaKey
+{
+    BigUInt<2 * HalfLimbs> n; ///< Modulus p·q
+    std::uint64_t e = 0;      ///< Public exponent
+    BigUInt<2 * HalfLimbs> d; ///< Private exponent, e^-1 mod lcm(p - 1, q - 1)
+    RsaCrtKey<HalfLimbs> crt; ///< p > q, dp, dq and qinv for RsaCrt
+};
+
+/**
+ * @brief Finds a random prime p of exactly bits bits with gcd(p - 1, e) = 1.
+ *
+ * One random start with its top two bits set is drawn. The sieve windows
+ * from it are walked in order (see CandidateSieve), and isProbablePrime()
+ * runs on the survivors until one is prime. Consecutive primes of a walk
+ * lie close together, so each search returns a single prime and a key's two
+ * primes always come from independent starts.
+ *
+ * @param bits Prime size, 64 < bits <= 64·Limbs
+ * @param e Odd public exponent
+ * @param random Source of the start
+ */
+template <std::size_t Limbs>
+BigUInt<Limbs> findPrime(std::size_t bits, std::uint64_t e, RandomSource &random)
+{
+    for (;;)
+    {
+        CandidateSieve<Limbs> sieve(random.oddWithTopBits<Limbs>(bits));
+
+        // Walk windows until the next one would run past bits bits, then draw a new start
+        while (sieve.candidate(SIEVE_WINDOW - 1).bitLength() == bits)
+        {
+            for (std::uint32_t offset : sieve.survivors())
+            {
+                BigUInt<Limbs> candidate = sieve.candidate(offset);
+                std::uint64_t pMinus1 = (candidate.modSmall(e) + e - 1) % e;
+                if (gcdWord(pMinus1, e) == 1 && isProbablePrime(candidate))
+                {
+                    return candidate;
+                }
+            }
+            sieve.advance();
+        }
+    }
+}
+
+/**
+ * @brief Pairwise consistency test: c = m^e mod n decrypts back to m with RsaCrt.
+ */
+template <std::size_t HalfLimbs>
+bool checkKey(const RsaKey<HalfLimbs> &key)
+{
+    using Full = BigUInt<2 * HalfLimbs>;
+    Full m = key.n / Full(3);
+    BigMontgomeryExp<2 * HalfLimbs> exp;
+    Full c = exp.compute(m, Full(key.e), key.n);
+
+    RsaCrt<HalfLimbs> crt(key.crt);
+    crt.setParallel(false); // Already on a worker thread
+    return crt.compute(c) == m;
+}
+
+/**
+ * @brief Derives the key of two primes, or returns false if the pair must be rejected.
+ *
+ * d = e^-1 mod lcm(p - 1, q - 1) is computed with the Lehmer engine, and
+ * qinv = q^-1 mod p with the constant-time safegcd engine. As in FIPS 186-4
+ * (B.3.1 and B.3.3), the pair is rejected when |p - q| <= 2^(bits - 100) or
+ * d <= 2^bits, where bits is the prime size. It is also rejected when
+ * checkKey() fails.
+ *
+ * @param p, q Distinct primes of the same size, each with gcd(prime - 1, e) = 1
+ * @param e Odd public exponent
+ * @param key Receives the key; p and q are ordered so that p > q
+ */
+template <std::size_t HalfLimbs>
+bool assembleKey(BigUInt<HalfLimbs> p, BigUInt<HalfLimbs> q, std::uint64_t e,
+                 RsaKey<HalfLimbs> &key)
+{
+    constexpr std::size_t FullLimbs = 2 * HalfLimbs;
+    using Half = BigUInt<HalfLimbs>;
+    using Full = BigUInt<FullLimbs>;
+
+    if (p < q)
+    {
+        std::swap(p, q);
+    }
+    std::size_t bits = p.bitLength();
+    if ((p - q).bitLength() + 100 <= bits)
+    {
+        return false;
+    }
+
+    Half pMinus1 = p - Half(1);
+    Half qMinus1 = q - Half(1);
+    BigInt<HalfLimbs> g =
+        gcd(BigInt<HalfLimbs>(pMinus1), BigInt<HalfLimbs>(qMinus1), GcdEngine::Lehmer);
+    Full lambda = multiplyWide(pMinus1, qMinus1) / g.magnitude().template resize<FullLimbs>();
+    BigInt<FullLimbs> d =
+        mod_inverse(BigInt<FullLimbs>(Full(e)), BigInt<FullLimbs>(lambda), GcdEngine::Lehmer);
+    if (d.isNegative() || d.magnitude().bitLength() <= bits)
+    {
+        return false;
+    }
+
+    key.n = multiplyWide(p, q);
+    key.e = e;
+    key.d = d.magnitude();
+    key.crt.p = p;
+    key.crt.q = q;
+    key.crt.dp = (key.d % pMinus1.template resize<FullLimbs>()).template resize<HalfLimbs>();
+    key.crt.dq = (key.d % qMinus1.template resize<FullLimbs>()).template resize<HalfLimbs>();
+    key.crt.qinv = mod_inverse(BigInt<HalfLimbs>(q), BigInt<HalfLimbs>(p), GcdEngine::SafeGcd)
+                       .magnitude();
+    return checkKey(key);
+}
+
+/**
+ * @class RsaKeyGenerator
+ * @brief Generates RSA keys on all cores.
+ *
+ * Key i needs the primes of searches 2i and 2i + 1. Worker threads take
+ * searches from a shared counter, and each runs its own sieve-and-test loop
+ * (findPrime()). The worker that completes a pair assembles and checks the
+ * key, so sieving, primality tests and key assembly of different keys
+ * overlap. A single key keeps only two threads busy.
+ *
+ * Keys are delivered in index order on the calling thread. With a seed,
+ * search j draws from RandomSource(seed, j, attempt), so the key set does
+ * not depend on the thread count or on scheduling.
+ */
+template <std::size_t HalfLimbs>
+class RsaKeyGenerator
+{
+public:
+    using Key = RsaKey<HalfLimbs>;
+    using Half = BigUInt<HalfLimbs>;
+
+    /**
+     * @param bits Modulus size: even, with 128 < bits <= 128·HalfLimbs
+     * @param e Public exponent: odd and >= 3
+     * @throws std::invalid_argument for an unsupported size or exponent
+     */
+    explicit RsaKeyGenerator(std::size_t bits, std::uint64_t e = RSA_DEFAULT_EXPONENT)
+        : bits_(bits),
+          e_(e),
+          threads_(0),
+          seeded_(false),
+          seed_(0)
+    {
+        if (bits % 2 != 0 || bits <= 128 || bits > 128 * HalfLimbs)
+        {
+            throw std::invalid_argument("RsaKeyGenerator: unsupported modulus size");
+        }
+        if (e < 3 || e % 2 == 0)
+        {
+            throw std::invalid_argument("RsaKeyGenerator: exponent must be odd and >= 3");
+        }
+    }
+
+    /**
+     * @brief Limit the worker threads; 0 uses the hardware concurrency.
+     */
+    void setThreads(std::size_t threads) { threads_ = threads; }
+
+    /**
+     * @brief Derive every prime search from seed (reproducible, not for real keys).
+     */
+    void setSeed(std::uint64_t seed)
+    {
+        seeded_ = true;
+        seed_ = seed;
+    }
+
+    /**
+     * @brief Generate count keys and pass them to sink(index, key) in index order.
+     *
+     * sink runs on the calling thread while the workers continue. An exception
+     * thrown by sink or a worker stops the run and is rethrown.
+     */
+    template <class Sink>
+    void generate(std::size_t count, Sink sink) const
+    {
+        const std::size_t searches = 2 * count;
+        std::vector<Half> primes(searches);
+        std::vector<std::uint8_t> found(searches, 0);
+        std::vector<Key> keys(count);
+        std::vector<std::uint8_t> ready(count, 0);
+        std::atomic<std::size_t> nextSearch(0);
+        std::mutex mutex;
+        std::condition_variable keyReady;
+        std::exception_ptr failure;
+
+        auto work = [&]()
+        {
+            try
+            {
+                for (std::size_t job; (job = nextSearch++) < searches;)
+                {
+                    Half prime = search(job, 0);
+                    std::size_t index = job / 2;
+                    {
+                        std::lock_guard<std::mutex> lock(mutex);
+                        primes[job] = prime;
+                        found[job] = 1;
+                        if (!found[job ^ 1])
+                        {
+                            continue; // The other worker of the pair assembles the key
+                        }
+                    }
+
+                    // Both primes are final once flagged; only this worker touches the pair now
+                    Key key;
+                    for (std::uint64_t attempt = 1;
+                         !assembleKey(primes[2 * index], primes[2 * index + 1], e_, key);
+                         ++attempt)
+                    {
+                        primes[2 * index + 1] = search(2 * index + 1, attempt);
+                    }
+                    {
+                        std::lock_guard<std::mutex> lock(mutex);
+                        keys[index] = key;
+                        ready[index] = 1;
+                    }
+                    keyReady.notify_all();
+                }
+            }
+            catch (...)
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                failure = std::current_exception();
+                nextSearch = searches;
+                keyReady.notify_all();
+            }
+        };
+
+        std::size_t threads = threads_ ? threads_ : std::thread::hardware_concurrency();
+        threads = std::max<std::size_t>(1, std::min(threads, searches));
+        std::vector<std::thread> workers;
+        for (std::size_t t = 0; t < threads; ++t)
+        {
+            workers.emplace_back(work);
+        }
+
+        try
+        {
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                Key key;
+                {
+                    std::unique_lock<std::mutex> lock(mutex);
+                    keyReady.wait(lock, [&]() { return ready[i] || failure; });
+                    if (!ready[i])
+                    {
+                        break;
+                    }
+                    key = keys[i];
+                }
+                sink(i, key);
+            }
+        }
+        catch (...)
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            failure = std::current_exception();
+            nextSearch = searches;
+        }
+
+        for (std::thread &worker : workers)
+        {
+            worker.join();
+        }
+        if (failure)
+        {
+            std::rethrow_exception(failure);
+        }
+    }
+
+private:
+    // Prime for search job; attempt > 0 replaces a prime whose pair was rejected
+    Half search(std::size_t job, std::uint64_t attempt) const
+    {
+        if (seeded_)
+        {
+            RandomSource random(seed_, job, attempt);
+            return findPrime<HalfLimbs>(bits_ / 2, e_, random);
+        }
+        RandomSource random;
+        return findPrime<HalfLimbs>(bits_ / 2, e_, random);
+    }
+
+    std::size_t bits_;    ///< Modulus size
+    std::uint64_t e_;     ///< Public exponent
+    std::size_t threads_; ///< Worker limit, 0 for hardware concurrency
+    bool seeded_;         ///< Derive the searches from seed_
+    std::uint64_t seed_;  ///< Seed of the run
+};
+
+#endif // RSA_KEYGEN_H
@@ -0,0 +1,24 @@
+#include "candidate_sieve.hpp"
+
+const std::vector<std::uint32_t> &sievePrimes()
+{
+    static const std::vector<std::uint32_t> primes = []()
+    {
+        std::vector<std::uint8_t> composite(SIEVE_PRIME_LIMIT, 0);
+        std::vector<std::uint32_t> odd;
+        for (std::uint32_t n = 3; n < SIEVE_PRIME_LIMIT; n += 2)
+        {
+            if (composite[n])
+            {
+                continue;
+            }
+            odd.push_back(n);
+            for (std::uint64_t m = std::uint64_t(n) * n; m < SIEVE_PRIME_LIMIT; m += 2 * n)
+            {
+                composite[m] = 1;
+            }
+        }
+        return odd;
+    }();
+    return primes;
+}
@@ -0,0 +1,203 @@
+#include "key_format.hpp"
+#include "rsa_keygen.hpp"
+#include <chrono>
+#include <cstdlib>
+#include <getopt.h>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+
+namespace
+{
+
+struct Options
+{
+    std::size_t bits = 2048;
+    std::size_t count = 1;
+    std::uint64_t exponent = RSA_DEFAULT_EXPONENT;
+    std::size_t threads = 0;
+    bool seeded = false;
+    std::uint64_t seed = 0;
+    KeyFormat format = KeyFormat::Pem;
+    bool verbose = false;
+};
+
+void printUsage(const char *program)
+{
+    std::cout << "Usage: " << program << " [options]\n"
+              << "\n"
+              << "Generates RSA key pairs and writes them to standard output in index order.\n"
+              << "Primes are found by sieving windows of consecutive odd candidates and testing\n"
+              << "the survivors with Miller-Rabin and strong Lucas (BPSW); every key passes an\n"
+              << "encrypt/CRT-decrypt consistency check before it is written.\n"
+              << "\n"
+              << "Options:\n"
+              << "  -b, --bits N         Modulus size: 512, 1024, 2048 (default), 3072 or 4096\n"
+              << "  -n, --count N        Number of keys (default 1)\n"
+              << "  -e, --exponent E     Public exponent, odd and >= 3 (default 65537)\n"
+              << "  -t, --threads N      Worker threads (default: all cores)\n"
+              << "  -s, --seed S         Reproducible keys from seed S (test fixtures only)\n"
+              << "  -o, --format FORMAT  pem (default), csv or json (one object per line)\n"
+              << "  -v, --verbose        Report the generation rate on standard error\n"
+              << "  -h, --help           Show this help\n";
+}
+
+// Parse a positive decimal or 0x-hex number; false if it is malformed or zero
+bool parsePositive(const char *text, std::uint64_t &value)
+{
+    try
+    {
+        std::size_t used = 0;
+        value = std::stoull(text, &used, 0);
+        return text[used] == '\0' && value > 0;
+    }
+    catch (const std::exception &)
+    {
+        return false;
+    }
+}
+
+template <std::size_t HalfLimbs>
+void generateKeys(const Options &options)
+{
+    RsaKeyGenerator<HalfLimbs> generator(options.bits, options.exponent);
+    generator.setThreads(options.threads);
+    if (options.seeded)
+    {
+        generator.setSeed(options.seed);
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    writeKeyHeader(std::cout, options.format);
+    generator.generate(options.count,
+                       [&](std::size_t, const RsaKey<HalfLimbs> &key)
+                       { writeKey(std::cout, keyText(key), options.format); });
+    std::cout.flush();
+
+    if (options.verbose)
+    {
+        double seconds =
+            std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        std::cerr << options.count << " key(s) of " << options.bits << " bits in " << seconds
+                  << " s (" << options.count / seconds << " keys/s)\n";
+    }
+}
+
+} // namespace
+
+int main(int argc, char *argv[])
+{
+    Options options;
+
+    static struct option longOptions[] = {
+        {"bits", required_argument, 0, 'b'},
+        {"count", required_argument, 0, 'n'},
+        {"exponent", required_argument, 0, 'e'},
+        {"threads", required_argument, 0, 't'},
+        {"seed", required_argument, 0, 's'},
+        {"format", required_argument, 0, 'o'},
+        {"verbose", no_argument, 0, 'v'},
+        {"help", no_argument, 0, 'h'},
+        {0, 0, 0, 0}};
+
+    int opt;
+    std::uint64_t value = 0;
+    while ((opt = getopt_long(argc, argv, "b:n:e:t:s:o:vh", longOptions, nullptr)) != -1)
+    {
+        switch (opt)
+        {
+        case 'b':
+        case 'n':
+        case 'e':
+        case 't':
+            if (!parsePositive(optarg, value))
+            {
+                std::cerr << "Error: expected a positive number, got '" << optarg << "'\n";
+                return EXIT_FAILURE;
+            }
+            if (opt == 'b')
+            {
+                options.bits = value;
+            }
+            else if (opt == 'n')
+            {
+                options.count = value;
+            }
+            else if (opt == 'e')
+            {
+                options.exponent = value;
+            }
+            else
+            {
+                options.threads = value;
+            }
+            break;
+        case 's':
+            try
+            {
+                options.seed = std::stoull(optarg, nullptr, 0);
+                options.seeded = true;
+            }
+            catch (const std::exception &)
+            {
+                std::cerr << "Error: invalid seed '" << optarg << "'\n";
+                return EXIT_FAILURE;
+            }
+            break;
+        case 'o':
+            if (!parseKeyFormat(optarg, options.format))
+            {
+                std::cerr << "Error: unknown format '" << optarg << "'\n";
+                return EXIT_FAILURE;
+            }
+            break;
+        case 'v':
+            options.verbose = true;
+            break;
+        case 'h':
+            printUsage(argv[0]);
+            return EXIT_SUCCESS;
+        default:
+            printUsage(argv[0]);
+            return EXIT_FAILURE;
+        }
+    }
+    if (optind < argc)
+    {
+        std::cerr << "Error: unexpected argument '" << argv[optind] << "'\n";
+        printUsage(argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    std::ios::sync_with_stdio(false);
+    try
+    {
+        switch (options.bits)
+        {
+        case 512:
+            generateKeys<4>(options);
+            break;
+        case 1024:
+            generateKeys<8>(options);
+            break;
+        case 2048:
+            generateKeys<16>(options);
+            break;
+        case 3072:
+            generateKeys<24>(options);
+            break;
+        case 4096:
+            generateKeys<32>(options);
+            break;
+        default:
+            std::cerr << "Error: unsupported modulus size " << options.bits << "\n";
+            return EXIT_FAILURE;
+        }
+    }
+    catch (const std::exception &error)
+    {
+        std::cerr << "Error: " << error.what() << "\n";
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
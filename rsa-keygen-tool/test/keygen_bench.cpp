@@ -0,0 +1,157 @@
+/**
+ * @file keygen_bench.cpp
+ * @brief Throughput benchmark for prime search and RSA key generation (run with `make bench`).
+ *
+ * Usage: keygen_bench [--format csv|json] [--max-bits <bits>]
+ *
+ * For each key size, two prime searches for the half-size primes are timed
+ * on one thread. "prime-sieve" is findPrime(): it sieves windows of
+ * consecutive odd candidates from one random start. "prime-random" draws an
+ * independent random odd candidate each time and runs isProbablePrime() on
+ * it, whose trial division is the only filter. Both use the same seeded
+ * sources and the same gcd(p - 1, e) = 1 condition. Then whole keys are
+ * generated by RsaKeyGenerator on one thread and on all cores.
+ *
+ * Prime search times follow the prime gaps, so each measurement runs for at
+ * least MIN_SECONDS and MIN_OPS operations. A row is verified when every
+ * prime (or key modulus) has the requested size and every prime passes a
+ * second isProbablePrime() call.
+ */
+
+#include "bench_harness.hpp"
+#include "rsa_keygen.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <thread>
+
+namespace
+{
+
+// Minimum wall time and operation count per measurement
+constexpr double MIN_SECONDS = 1.0;
+constexpr std::size_t MIN_OPS = 8;
+
+// Seed of the random sources; each operation uses its own stream
+constexpr std::uint64_t SEED = 0x5eed;
+
+// Rows by modulus size; the primes have half as many bits
+BenchReport report({"method"}, {}, "ms_per_op", 1e3);
+std::size_t failures = 0;
+
+// Run body(i) for i = 0, 1, ... until MIN_SECONDS and MIN_OPS are reached; body returns success
+template <class Body>
+void timedLoop(std::size_t bits, const std::string &method, Body body)
+{
+    bool verified = true;
+    std::size_t ops = 0;
+    double start = benchNow();
+    double elapsed = 0;
+    do
+    {
+        verified = body(ops++) && verified;
+        elapsed = benchNow() - start;
+    } while (elapsed < MIN_SECONDS || ops < MIN_OPS);
+
+    failures += verified ? 0 : 1;
+    report.add(bits, {method}, static_cast<double>(ops), elapsed, verified);
+}
+
+// Prime search by independent draws: each candidate is a fresh random odd number
+template <std::size_t Limbs>
+BigUInt<Limbs> randomPrime(std::size_t bits, std::uint64_t e, RandomSource &random)
+{
+    for (;;)
+    {
+        BigUInt<Limbs> candidate = random.oddWithTopBits<Limbs>(bits);
+        std::uint64_t pMinus1 = (candidate.modSmall(e) + e - 1) % e;
+        if (gcdWord(pMinus1, e) == 1 && isProbablePrime(candidate))
+        {
+            return candidate;
+        }
+    }
+}
+
+template <std::size_t HalfLimbs>
+void benchKeySize(std::size_t bits)
+{
+    using Half = BigUInt<HalfLimbs>;
+    const std::size_t primeBits = bits / 2;
+    auto checkPrime = [&](const Half &prime)
+    { return prime.bitLength() == primeBits && isProbablePrime(prime); };
+
+    timedLoop(bits, "prime-sieve",
+              [&](std::size_t i)
+              {
+                  RandomSource random(SEED, i, 0);
+                  return checkPrime(findPrime<HalfLimbs>(primeBits, RSA_DEFAULT_EXPONENT, random));
+              });
+    timedLoop(bits, "prime-random",
+              [&](std::size_t i)
+              {
+                  RandomSource random(SEED, i, 0);
+                  return checkPrime(
+                      randomPrime<HalfLimbs>(primeBits, RSA_DEFAULT_EXPONENT, random));
+              });
+
+    std::size_t cores = std::max(1u, std::thread::hardware_concurrency());
+    for (std::size_t threads : {std::size_t(1), cores})
+    {
+        RsaKeyGenerator<HalfLimbs> generator(bits);
+        generator.setSeed(SEED);
+        generator.setThreads(threads);
+
+        // One batch of keys per operation, so every core has searches to take
+        const std::size_t batch = 2 * threads;
+        timedLoop(bits, "keygen-" + std::to_string(threads) + "t",
+                  [&](std::size_t)
+                  {
+                      bool ok = true;
+                      generator.generate(batch,
+                                         [&](std::size_t, const RsaKey<HalfLimbs> &key)
+                                         { ok = ok && key.n.bitLength() == bits; });
+                      return ok;
+                  });
+        report.lastOps() *= static_cast<double>(batch);
+        if (threads == cores)
+        {
+            break;
+        }
+    }
+}
+
+} // namespace
+
+int main(int argc, char *argv[])
+{
+    BenchArgs args;
+    if (!parseBenchArgs(argc, argv, args))
+    {
+        return EXIT_FAILURE;
+    }
+
+    benchKeySize<8>(1024);
+    if (args.maxBits >= 2048)
+    {
+        benchKeySize<16>(2048);
+    }
+    if (args.maxBits >= 3072)
+    {
+        benchKeySize<24>(3072);
+    }
+    if (args.maxBits >= 4096)
+    {
+        benchKeySize<32>(4096);
+    }
+
+    report.print(std::cout, args.json);
+
+    if (failures > 0)
+    {
+        std::cerr << failures << " measurement(s) produced an invalid prime or key" << std::endl;
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}